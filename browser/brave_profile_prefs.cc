@@ -5,8 +5,8 @@
 
 #include "brave/browser/brave_profile_prefs.h"
 
+#include "brave/browser/search_engines/search_engine_tracker.h"
 #include "brave/browser/themes/brave_dark_mode_utils.h"
-#include "brave/browser/ui/omnibox/brave_omnibox_client_impl.h"
 #include "brave/common/brave_wallet_constants.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/binance/browser/buildflags/buildflags.h"
@@ -237,9 +237,7 @@ void RegisterProfilePrefs(user_prefs::PrefRegistrySyncable* registry) {
   speedreader::SpeedreaderService::RegisterPrefs(registry);
 #endif
 
-#if !defined(OS_ANDROID)
-  BraveOmniboxClientImpl::RegisterPrefs(registry);
-#endif
+  SearchEngineTracker::RegisterProfilePrefs(registry);
 
   RegisterProfilePrefsForMigration(registry);
 }
@@ -11,6 +11,7 @@
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/url_constants.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
 #include "chrome/browser/extensions/crx_installer.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
@@ -22,6 +23,9 @@ class BraveExtensionProviderTest : public extensions::ExtensionFunctionalTest {
  public:
   void SetUpOnMainThread() override {
     extensions::ExtensionFunctionalTest::SetUpOnMainThread();
+    // Write blocked counts through so the stats checks are not vacuous.
+    brave_shields::BraveShieldsWebContentsObserver::
+        SetStatsFlushIntervalForTesting(base::TimeDelta());
   }
 };
 
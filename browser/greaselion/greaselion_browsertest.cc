@@ -3,8 +3,12 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <set>
+
 #include "base/path_service.h"
 #include "base/run_loop.h"
+#include "base/strings/string_util.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
@@ -18,6 +22,7 @@
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
 #include "net/dns/mock_host_resolver.h"
 
 using brave_rewards::RewardsService;
@@ -120,6 +125,18 @@ class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
     g_brave_browser_process->greaselion_download_service()->rules()->clear();
   }
 
+  // Returns the currently enabled Greaselion extensions.
+  std::set<const extensions::Extension*> GetGreaselionExtensions() {
+    std::set<const extensions::Extension*> result;
+    for (const auto& extension :
+         extensions::ExtensionRegistry::Get(profile())->enabled_extensions()) {
+      if (base::StartsWith(extension->name(), "greaselion-",
+                           base::CompareCase::SENSITIVE))
+        result.insert(extension.get());
+    }
+    return result;
+  }
+
   void SetRewardsEnabled(bool enabled) {
     RewardsService* rewards_service =
         RewardsServiceFactory::GetForProfile(profile());
@@ -250,3 +267,27 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ScriptInjectionWithPrecondition) {
   // Greaselion rule is active
   EXPECT_EQ(title, "Altered");
 }
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, UpdateReusesUnchangedExtensions) {
+  ASSERT_TRUE(InstallMockExtension());
+  const auto extensions = GetGreaselionExtensions();
+  ASSERT_FALSE(extensions.empty());
+
+  // Repeated no-op updates must neither reconvert nor reload anything.
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  for (int i = 0; i < 3; ++i) {
+    greaselion_service->UpdateInstalledExtensions();
+    GreaselionServiceWaiter(greaselion_service).Wait();
+    EXPECT_EQ(extensions, GetGreaselionExtensions());
+  }
+
+  // Enabling rewards adds the rules with a rewards precondition; the
+  // extensions of all other rules are kept as is.
+  SetRewardsEnabled(true);
+  const auto updated_extensions = GetGreaselionExtensions();
+  EXPECT_GT(updated_extensions.size(), extensions.size());
+  EXPECT_TRUE(std::includes(updated_extensions.begin(),
+                            updated_extensions.end(), extensions.begin(),
+                            extensions.end()));
+}
@@ -10,6 +10,7 @@
 
 #include "base/base64url.h"
 #include "base/strings/string_util.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
@@ -28,6 +29,7 @@
 namespace brave {
 
 void ShouldBlockAdOnTaskRunner(std::shared_ptr<BraveRequestInfo> ctx) {
+  TRACE_EVENT0("browser", "ShouldBlockAdOnTaskRunner");
   bool did_match_exception = false;
   std::string tab_host = ctx->tab_origin.host();
   if (!g_brave_browser_process->ad_block_service()->ShouldStartRequest(
@@ -11,6 +11,7 @@
 
 #include "base/task/post_task.h"
 #include "base/threading/scoped_blocking_call.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
@@ -23,6 +24,7 @@ namespace brave {
 
 void OnBeforeURLRequest_HttpseFileWork(
     std::shared_ptr<BraveRequestInfo> ctx) {
+  TRACE_EVENT0("browser", "OnBeforeURLRequest_HttpseFileWork");
   base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
                                                 base::BlockingType::WILL_BLOCK);
   DCHECK_NE(ctx->request_identifier, 0U);
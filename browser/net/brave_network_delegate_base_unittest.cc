@@ -61,9 +61,8 @@ TEST_F(BraveNetworkDelegateBaseTest, RemoveTrackableSecurityHeaders) {
   scoped_refptr<HttpResponseHeaders> headers(
       new HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(kRawHeaders)));
 
-  RemoveTrackableSecurityHeadersForThirdParty(request_url,
-                                              url::Origin::Create(tab_url),
-                                              nullptr, &headers);
+  RemoveTrackableSecurityHeadersForThirdParty(request_url, tab_url, nullptr,
+                                              &headers);
   for (auto header : *TrackableSecurityHeaders()) {
     EXPECT_FALSE(headers->HasHeader(header.as_string()));
   }
@@ -79,9 +78,8 @@ TEST_F(BraveNetworkDelegateBaseTest, RemoveTrackableSecurityHeadersMixedCase) {
   scoped_refptr<HttpResponseHeaders> headers(
       new HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(kRawHeaders)));
 
-  RemoveTrackableSecurityHeadersForThirdParty(request_url,
-                                              url::Origin::Create(tab_url),
-                                              nullptr, &headers);
+  RemoveTrackableSecurityHeadersForThirdParty(request_url, tab_url, nullptr,
+                                              &headers);
   for (auto header : *TrackableSecurityHeaders()) {
     EXPECT_FALSE(headers->HasHeader(header.as_string()));
   }
@@ -97,9 +95,8 @@ TEST_F(BraveNetworkDelegateBaseTest, RetainTrackableSecurityHeaders) {
   scoped_refptr<HttpResponseHeaders> headers(
       new HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(kRawHeaders)));
 
-  RemoveTrackableSecurityHeadersForThirdParty(request_url,
-                                              url::Origin::Create(tab_url),
-                                              nullptr, &headers);
+  RemoveTrackableSecurityHeadersForThirdParty(request_url, tab_url, nullptr,
+                                              &headers);
   for (auto header : *TrackableSecurityHeaders()) {
     EXPECT_TRUE(headers->HasHeader(header.as_string()));
   }
@@ -107,4 +104,41 @@ TEST_F(BraveNetworkDelegateBaseTest, RetainTrackableSecurityHeaders) {
   EXPECT_TRUE(headers->HasHeader(kXSSProtectionHeader));
 }
 
+TEST_F(BraveNetworkDelegateBaseTest,
+       RemoveTrackableSecurityHeadersFromOriginalHeaders) {
+  GURL request_url(kThirdPartyDomain);
+  GURL tab_url(kFirstPartyDomain);
+
+  scoped_refptr<HttpResponseHeaders> original_headers(
+      new HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(kRawHeaders)));
+  scoped_refptr<HttpResponseHeaders> override_headers;
+
+  RemoveTrackableSecurityHeadersForThirdParty(
+      request_url, tab_url, original_headers.get(), &override_headers);
+  ASSERT_TRUE(override_headers);
+  for (auto header : *TrackableSecurityHeaders()) {
+    EXPECT_FALSE(override_headers->HasHeader(header.as_string()));
+    EXPECT_TRUE(original_headers->HasHeader(header.as_string()));
+  }
+  EXPECT_TRUE(override_headers->HasHeader(kAcceptLanguageHeader));
+  EXPECT_TRUE(override_headers->HasHeader(kXSSProtectionHeader));
+}
+
+TEST_F(BraveNetworkDelegateBaseTest,
+       NoOverrideHeadersWithoutTrackableSecurityHeaders) {
+  GURL request_url(kThirdPartyDomain);
+  GURL tab_url(kFirstPartyDomain);
+
+  scoped_refptr<HttpResponseHeaders> original_headers(
+      new HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(
+          "HTTP/1.0 200 OK\n"
+          "Accept-Language: *\n"
+          "X-XSS-Protection: 0")));
+  scoped_refptr<HttpResponseHeaders> override_headers;
+
+  RemoveTrackableSecurityHeadersForThirdParty(
+      request_url, tab_url, original_headers.get(), &override_headers);
+  EXPECT_FALSE(override_headers);
+}
+
 }  // namespace
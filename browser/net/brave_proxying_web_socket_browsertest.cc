@@ -0,0 +1,90 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "base/path_service.h"
+#include "base/strings/stringprintf.h"
+#include "brave/common/brave_paths.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+#include "net/test/spawned_test_server/spawned_test_server.h"
+#include "net/test/test_data_directory.h"
+#include "testing/perf/perf_test.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr int kHandshakeCount = 20;
+
+// Opens |count| sockets one after another and resolves with the median time
+// from construction to the open event, in milliseconds.
+constexpr char kMeasureHandshakesScript[] = R"(
+    (async () => {
+      const times = [];
+      for (let i = 0; i < %d; ++i) {
+        const start = performance.now();
+        await new Promise((resolve, reject) => {
+          const ws = new WebSocket('%s');
+          ws.onopen = () => {
+            times.push(performance.now() - start);
+            ws.close();
+            resolve();
+          };
+          ws.onerror = () => reject('handshake failed');
+        });
+      }
+      times.sort((a, b) => a - b);
+      return times[Math.floor(times.length / 2)];
+    })();
+)";
+
+}  // namespace
+
+class BraveProxyingWebSocketBrowserTest : public InProcessBrowserTest {
+ public:
+  BraveProxyingWebSocketBrowserTest()
+      : ws_server_(net::SpawnedTestServer::TYPE_WS,
+                   net::GetWebSocketTestDataDirectory()) {}
+
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+    host_resolver()->AddRule("*", "127.0.0.1");
+
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    embedded_test_server()->ServeFilesFromDirectory(test_data_dir);
+    ASSERT_TRUE(embedded_test_server()->Start());
+    ASSERT_TRUE(ws_server_.Start());
+  }
+
+  content::WebContents* contents() {
+    return browser()->tab_strip_model()->GetActiveWebContents();
+  }
+
+ protected:
+  net::SpawnedTestServer ws_server_;
+};
+
+// Shields are on by default, so every handshake goes through the WebSocket
+// proxy and the socket helpers of BraveRequestHandler.
+IN_PROC_BROWSER_TEST_F(BraveProxyingWebSocketBrowserTest,
+                       HandshakeLatencyWithShieldsUp) {
+  ui_test_utils::NavigateToURL(
+      browser(), embedded_test_server()->GetURL("a.com", "/simple.html"));
+
+  const GURL ws_url = ws_server_.GetURL("echo-with-no-extension");
+  content::EvalJsResult result = content::EvalJs(
+      contents(), base::StringPrintf(kMeasureHandshakesScript,
+                                     kHandshakeCount, ws_url.spec().c_str()));
+  ASSERT_TRUE(result.error.empty()) << result.error;
+
+  perf_test::PrintResult("brave_proxying_web_socket", "", "handshake_median",
+                         result.ExtractDouble(), "ms", true);
+}
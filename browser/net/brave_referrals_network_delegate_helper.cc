@@ -5,12 +5,8 @@
 
 #include "brave/browser/net/brave_referrals_network_delegate_helper.h"
 
-#include "base/values.h"
-#include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/common/network_constants.h"
-#include "chrome/browser/browser_process.h"
-#include "content/public/browser/browser_thread.h"
-#include "extensions/common/url_pattern.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #include "net/url_request/url_request.h"
 
 namespace brave {
@@ -19,17 +15,17 @@ int OnBeforeStartTransaction_ReferralsWork(
     net::HttpRequestHeaders* headers,
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
-  if (!ctx->referral_headers_list)
+  if (!ctx->referral_headers_matcher)
     return net::OK;
   // If the domain for this request matches one of our target domains,
   // set the associated custom headers.
-  const base::DictionaryValue* request_headers_dict = nullptr;
-  if (!BraveReferralsService::GetMatchingReferralHeaders(
-          *ctx->referral_headers_list, &request_headers_dict, ctx->request_url))
+  const ReferralHeadersMatcher::Headers* request_headers =
+      ctx->referral_headers_matcher->GetMatchingHeaders(ctx->request_url);
+  if (!request_headers)
     return net::OK;
-  for (const auto& it : request_headers_dict->DictItems()) {
+  for (const auto& it : *request_headers) {
     if (it.first == kBravePartnerHeader) {
-      headers->SetHeader(it.first, it.second.GetString());
+      headers->SetHeader(it.first, it.second);
       ctx->set_headers.insert(it.first);
     }
   }
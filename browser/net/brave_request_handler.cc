@@ -6,10 +6,14 @@
 #include "brave/browser/net/brave_request_handler.h"
 
 #include <algorithm>
+#include <string>
 #include <utility>
 
+#include "base/metrics/histogram.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/strings/strcat.h"
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 #include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
 #include "brave/browser/net/brave_httpse_network_delegate_helper.h"
@@ -27,9 +31,11 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/common/url_constants.h"
 #include "extensions/common/constants.h"
+#include "net/http/http_response_headers.h"
 
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 #include "brave/browser/net/brave_referrals_network_delegate_helper.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #endif
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
@@ -59,45 +65,107 @@ BraveRequestHandler::BraveRequestHandler() {
 
 BraveRequestHandler::~BraveRequestHandler() = default;
 
-void BraveRequestHandler::SetupCallbacks() {
-  brave::OnBeforeURLRequestCallback callback =
-      base::Bind(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
+// static
+template <typename Callback>
+void BraveRequestHandler::AddHelper(std::vector<Helper<Callback>>* helpers,
+                                    const Callback& callback,
+                                    const brave::HelperFilter& filter) {
+  // The dispatch plan has one bit per helper.
+  DCHECK_LT(helpers->size(), 32u);
+  base::HistogramBase* histogram = base::Histogram::FactoryMicrosecondsTimeGet(
+      base::StrCat({"Brave.NetworkHelper.", filter.name}),
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+      50, base::HistogramBase::kUmaTargetedHistogramFlag);
+  helpers->push_back({callback, filter, histogram});
+}
 
-  callback = base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
+// static
+template <typename Callback>
+bool BraveRequestHandler::BuildDispatchPlan(
+    const std::vector<Helper<Callback>>& helpers,
+    const std::string* mime_type,
+    brave::BraveRequestInfo* ctx) {
+  ctx->dispatch_plan = 0;
+  for (size_t i = 0; i < helpers.size(); ++i) {
+    const brave::HelperFilter& filter = helpers[i].filter;
+    if (filter.MatchesRequest(*ctx) &&
+        (!mime_type || filter.MatchesResponse(*mime_type))) {
+      ctx->dispatch_plan |= 1u << i;
+    }
+  }
+  return ctx->dispatch_plan != 0;
+}
 
-  callback = base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+void BraveRequestHandler::SetupCallbacks() {
+  using brave::HelperFilter;
+  const uint32_t kHttpSchemes = HelperFilter::kHttp | HelperFilter::kHttps;
+
+  AddHelper(&before_url_request_callbacks_,
+            brave::OnBeforeURLRequestCallback(
+                base::Bind(brave::OnBeforeURLRequest_SiteHacksWork)),
+            HelperFilter("SiteHacks"));
+
+  // Blocks some resources regardless of the tab, so no tab origin required.
+  AddHelper(&before_url_request_callbacks_,
+            brave::OnBeforeURLRequestCallback(
+                base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork)),
+            HelperFilter("AdBlockTP"));
+
+  HelperFilter httpse_filter("HttpsEverywhere");
+  httpse_filter.schemes = kHttpSchemes;
+  httpse_filter.requires_tab_origin = true;
+  AddHelper(&before_url_request_callbacks_,
+            brave::OnBeforeURLRequestCallback(
+                base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork)),
+            httpse_filter);
+
+  // WebSocket handshakes only honour blocking (see BraveProxyingWebSocket),
+  // so the redirect and reporting helpers below are limited to http(s) and
+  // sockets only pay for ad-block and the referrer/header policy helpers.
+  HelperFilter static_redirect_filter("StaticRedirect");
+  static_redirect_filter.schemes = kHttpSchemes;
+  AddHelper(&before_url_request_callbacks_,
+            brave::OnBeforeURLRequestCallback(base::Bind(
+                brave::OnBeforeURLRequest_CommonStaticRedirectWork)),
+            static_redirect_filter);
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
-  callback = base::Bind(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  HelperFilter rewards_filter("Rewards");
+  rewards_filter.schemes = kHttpSchemes;
+  AddHelper(&before_url_request_callbacks_,
+            brave::OnBeforeURLRequestCallback(
+                base::Bind(brave_rewards::OnBeforeURLRequest)),
+            rewards_filter);
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  HelperFilter translate_filter("TranslateRedirect");
+  translate_filter.schemes = kHttpSchemes;
+  AddHelper(&before_url_request_callbacks_,
+            brave::OnBeforeURLRequestCallback(base::BindRepeating(
+                brave::OnBeforeURLRequest_TranslateRedirectWork)),
+            translate_filter);
 #endif
 
-  brave::OnBeforeStartTransactionCallback start_transaction_callback =
-      base::Bind(brave::OnBeforeStartTransaction_SiteHacksWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  AddHelper(&before_start_transaction_callbacks_,
+            brave::OnBeforeStartTransactionCallback(
+                base::Bind(brave::OnBeforeStartTransaction_SiteHacksWork)),
+            HelperFilter("SiteHacksHeaders"));
 
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
-  start_transaction_callback =
-      base::Bind(brave::OnBeforeStartTransaction_ReferralsWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  HelperFilter referrals_filter("Referrals");
+  referrals_filter.schemes = kHttpSchemes;
+  AddHelper(&before_start_transaction_callbacks_,
+            brave::OnBeforeStartTransactionCallback(
+                base::Bind(brave::OnBeforeStartTransaction_ReferralsWork)),
+            referrals_filter);
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
-  brave::OnHeadersReceivedCallback headers_received_callback =
-      base::Bind(webtorrent::OnHeadersReceived_TorrentRedirectWork);
-  headers_received_callbacks_.push_back(headers_received_callback);
+  AddHelper(&headers_received_callbacks_,
+            brave::OnHeadersReceivedCallback(
+                base::Bind(webtorrent::OnHeadersReceived_TorrentRedirectWork)),
+            webtorrent::GetTorrentRedirectFilter());
 #endif
 }
 
@@ -118,10 +186,14 @@ void BraveRequestHandler::InitPrefChangeRegistrar() {
 
 void BraveRequestHandler::OnReferralHeadersChanged() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+#if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
   if (const base::ListValue* referral_headers =
           g_browser_process->local_state()->GetList(kReferralHeaders)) {
-    referral_headers_list_.reset(referral_headers->DeepCopy());
+    referral_headers_matcher_ =
+        std::make_shared<const brave::ReferralHeadersMatcher>(
+            *referral_headers);
   }
+#endif
 }
 
 bool BraveRequestHandler::IsRequestIdentifierValid(
@@ -133,30 +205,31 @@ int BraveRequestHandler::OnBeforeURLRequest(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     GURL* new_url) {
-  if (before_url_request_callbacks_.empty() || IsInternalScheme(ctx)) {
+  TRACE_EVENT0("browser", "BraveRequestHandler::OnBeforeURLRequest");
+  if (IsInternalScheme(ctx) ||
+      !BuildDispatchPlan(before_url_request_callbacks_, nullptr, ctx.get())) {
     return net::OK;
   }
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.OnBeforeURLRequest_Handler");
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(ctx, std::move(callback));
 }
 
 int BraveRequestHandler::OnBeforeStartTransaction(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     net::HttpRequestHeaders* headers) {
-  if (before_start_transaction_callbacks_.empty() || IsInternalScheme(ctx)) {
+  TRACE_EVENT0("browser", "BraveRequestHandler::OnBeforeStartTransaction");
+  if (IsInternalScheme(ctx) ||
+      !BuildDispatchPlan(before_start_transaction_callbacks_, nullptr,
+                         ctx.get())) {
     return net::OK;
   }
   ctx->event_type = brave::kOnBeforeStartTransaction;
   ctx->headers = headers;
-  ctx->referral_headers_list = referral_headers_list_.get();
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  ctx->referral_headers_matcher = referral_headers_matcher_;
+  return StartCallbacks(ctx, std::move(callback));
 }
 
 int BraveRequestHandler::OnHeadersReceived(
@@ -165,48 +238,71 @@ int BraveRequestHandler::OnHeadersReceived(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url) {
+  TRACE_EVENT0("browser", "BraveRequestHandler::OnHeadersReceived");
   if (!ctx->tab_origin.is_empty()) {
     brave::RemoveTrackableSecurityHeadersForThirdParty(
-        ctx->request_url, url::Origin::Create(ctx->tab_origin),
-        original_response_headers, override_response_headers);
+        ctx->request_url, ctx->tab_origin, original_response_headers,
+        override_response_headers);
   }
 
-  if (headers_received_callbacks_.empty() &&
-      !ctx->request_url.SchemeIs(content::kChromeUIScheme)) {
-    // Extension scheme not excluded since brave_webtorrent needs it.
+  // Extension scheme not excluded since brave_webtorrent needs it.
+  std::string mime_type;
+  if (original_response_headers) {
+    original_response_headers->GetMimeType(&mime_type);
+  }
+  const bool run_callbacks =
+      !ctx->request_url.SchemeIs(content::kChromeUIScheme) &&
+      BuildDispatchPlan(headers_received_callbacks_, &mime_type, ctx.get());
+  UMA_HISTOGRAM_BOOLEAN("Brave.OnHeadersReceived_RunsHelpers", run_callbacks);
+  if (!run_callbacks) {
     return net::OK;
   }
 
-  callbacks_[ctx->request_identifier] = std::move(callback);
   ctx->event_type = brave::kOnHeadersReceived;
   ctx->original_response_headers = original_response_headers;
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
 
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(ctx, std::move(callback));
 }
 
 void BraveRequestHandler::OnURLRequestDestroyed(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
-  if (base::Contains(callbacks_, ctx->request_identifier)) {
-    callbacks_.erase(ctx->request_identifier);
-  }
+  callbacks_.erase(ctx->request_identifier);
 }
 
 void BraveRequestHandler::RunCallbackForRequestIdentifier(
     uint64_t request_identifier,
     int rv) {
-  std::map<uint64_t, net::CompletionOnceCallback>::iterator it =
-      callbacks_.find(request_identifier);
+  auto it = callbacks_.find(request_identifier);
+  if (it == callbacks_.end())
+    return;
+  net::CompletionOnceCallback callback = std::move(it->second);
+  callbacks_.erase(it);
   // We intentionally do the async call to maintain the proper flow
   // of URLLoader callbacks.
   base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(std::move(it->second), rv));
+                 base::BindOnce(std::move(callback), rv));
+}
+
+int BraveRequestHandler::StartCallbacks(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    net::CompletionOnceCallback callback) {
+  const int rv = RunCallbacks(ctx);
+  // Nothing went async and nothing failed, most requests end up here. Let the
+  // caller carry on synchronously instead of posting |callback| and keeping
+  // it around until then.
+  if (rv == net::OK)
+    return net::OK;
+
+  // Helpers which went async continue through RunNextCallback and need to
+  // find |callback| there. Failures are reported through |callback| too.
+  callbacks_[ctx->request_identifier] = std::move(callback);
+  if (rv != net::ERR_IO_PENDING)
+    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+  return net::ERR_IO_PENDING;
 }
 
-// TODO(iefremov): Merge all callback containers into one and run only one loop
-// instead of many (issues/5574).
 void BraveRequestHandler::RunNextCallback(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -215,21 +311,43 @@ void BraveRequestHandler::RunNextCallback(
     return;
   }
 
+  const int rv = RunCallbacks(ctx);
+  if (rv == net::ERR_IO_PENDING)
+    return;
+  RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+}
+
+// TODO(iefremov): Merge all callback containers into one and run only one loop
+// instead of many (issues/5574).
+int BraveRequestHandler::RunCallbacks(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  TRACE_EVENT1("browser", "BraveRequestHandler::RunCallbacks",
+               "event_type", static_cast<int>(ctx->event_type));
+
   // Continue processing callbacks until we hit one that returns PENDING
   int rv = net::OK;
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
     while (before_url_request_callbacks_.size() !=
            ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
-          before_url_request_callbacks_[ctx->next_url_request_index++];
+      const size_t index = ctx->next_url_request_index++;
+      if (!(ctx->dispatch_plan & (1u << index))) {
+        continue;
+      }
+      const auto& helper = before_url_request_callbacks_[index];
+      TRACE_EVENT1("browser", "BraveRequestHandler::RunHelper", "helper",
+                   helper.filter.name);
       brave::ResponseCallback next_callback = base::Bind(
           &BraveRequestHandler::RunNextCallback,
           weak_factory_.GetWeakPtr(),
           ctx);
-      rv = callback.Run(next_callback, ctx);
+      const base::TimeTicks start = base::TimeTicks::Now();
+      rv = helper.callback.Run(next_callback, ctx);
+      helper.histogram->AddTimeMicrosecondsGranularity(
+          base::TimeTicks::Now() - start);
       if (rv == net::ERR_IO_PENDING) {
-        return;
+        return rv;
       }
       if (rv != net::OK) {
         break;
@@ -238,15 +356,23 @@ void BraveRequestHandler::RunNextCallback(
   } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
     while (before_start_transaction_callbacks_.size() !=
            ctx->next_url_request_index) {
-      brave::OnBeforeStartTransactionCallback callback =
-          before_start_transaction_callbacks_[ctx->next_url_request_index++];
+      const size_t index = ctx->next_url_request_index++;
+      if (!(ctx->dispatch_plan & (1u << index))) {
+        continue;
+      }
+      const auto& helper = before_start_transaction_callbacks_[index];
+      TRACE_EVENT1("browser", "BraveRequestHandler::RunHelper", "helper",
+                   helper.filter.name);
       brave::ResponseCallback next_callback = base::Bind(
           &BraveRequestHandler::RunNextCallback,
           weak_factory_.GetWeakPtr(),
           ctx);
-      rv = callback.Run(ctx->headers, next_callback, ctx);
+      const base::TimeTicks start = base::TimeTicks::Now();
+      rv = helper.callback.Run(ctx->headers, next_callback, ctx);
+      helper.histogram->AddTimeMicrosecondsGranularity(
+          base::TimeTicks::Now() - start);
       if (rv == net::ERR_IO_PENDING) {
-        return;
+        return rv;
       }
       if (rv != net::OK) {
         break;
@@ -254,17 +380,26 @@ void BraveRequestHandler::RunNextCallback(
     }
   } else if (ctx->event_type == brave::kOnHeadersReceived) {
     while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnHeadersReceivedCallback callback =
-          headers_received_callbacks_[ctx->next_url_request_index++];
+      const size_t index = ctx->next_url_request_index++;
+      if (!(ctx->dispatch_plan & (1u << index))) {
+        continue;
+      }
+      const auto& helper = headers_received_callbacks_[index];
+      TRACE_EVENT1("browser", "BraveRequestHandler::RunHelper", "helper",
+                   helper.filter.name);
       brave::ResponseCallback next_callback = base::Bind(
           &BraveRequestHandler::RunNextCallback,
           weak_factory_.GetWeakPtr(),
           ctx);
-      rv = callback.Run(ctx->original_response_headers,
-                        ctx->override_response_headers,
-                        ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+      const base::TimeTicks start = base::TimeTicks::Now();
+      rv = helper.callback.Run(ctx->original_response_headers,
+                               ctx->override_response_headers,
+                               ctx->allowed_unsafe_redirect_url, next_callback,
+                               ctx);
+      helper.histogram->AddTimeMicrosecondsGranularity(
+          base::TimeTicks::Now() - start);
       if (rv == net::ERR_IO_PENDING) {
-        return;
+        return rv;
       }
       if (rv != net::OK) {
         break;
@@ -273,23 +408,19 @@ void BraveRequestHandler::RunNextCallback(
   }
 
   if (rv != net::OK) {
-    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
-    return;
+    return rv;
   }
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
     if (!ctx->new_url_spec.empty() &&
-        (ctx->new_url_spec != ctx->request_url.spec()) &&
-        IsRequestIdentifierValid(ctx->request_identifier)) {
+        (ctx->new_url_spec != ctx->request_url.spec())) {
       *ctx->new_url = GURL(ctx->new_url_spec);
     }
     if (ctx->blocked_by == brave::kAdBlocked) {
       if (ctx->cancel_request_explicitly) {
-        RunCallbackForRequestIdentifier(ctx->request_identifier,
-                                        net::ERR_ABORTED);
-        return;
+        return net::ERR_ABORTED;
       }
     }
   }
-  RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+  return rv;
 }
@@ -6,17 +6,21 @@
 #ifndef BRAVE_BROWSER_NET_BRAVE_REQUEST_HANDLER_H_
 #define BRAVE_BROWSER_NET_BRAVE_REQUEST_HANDLER_H_
 
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "brave/browser/net/url_context.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/completion_once_callback.h"
 
 class PrefChangeRegistrar;
 
+namespace base {
+class HistogramBase;
+}
+
 // Contains different network stack hooks (similar to capabilities of WebRequest
 // API).
 class BraveRequestHandler {
@@ -52,20 +56,55 @@ class BraveRequestHandler {
   void OnPreferenceChanged(const std::string& pref_name);
   void UpdateAdBlockFromPref(const std::string& pref_name);
 
+  // Runs the helpers for |ctx|'s stage. Returns net::OK when they all
+  // completed synchronously without touching the request's fate, in which
+  // case |callback| is dropped and never run. Otherwise |callback| runs once
+  // the helpers are done and net::ERR_IO_PENDING is returned.
+  int StartCallbacks(std::shared_ptr<brave::BraveRequestInfo> ctx,
+                     net::CompletionOnceCallback callback);
+  // Continues the helpers after one of them completed asynchronously.
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
-
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
-  std::vector<brave::OnBeforeStartTransactionCallback>
+  // Runs helpers from |ctx->next_url_request_index| until one goes async
+  // (net::ERR_IO_PENDING) or all are done, returning the stage's result.
+  int RunCallbacks(std::shared_ptr<brave::BraveRequestInfo> ctx);
+
+  // A registered helper and the requests it applies to.
+  template <typename Callback>
+  struct Helper {
+    Callback callback;
+    brave::HelperFilter filter;
+    // Times the synchronous part of |callback|.
+    base::HistogramBase* histogram;
+  };
+  template <typename Callback>
+  static void AddHelper(std::vector<Helper<Callback>>* helpers,
+                        const Callback& callback,
+                        const brave::HelperFilter& filter);
+  // Records in |ctx| which of |helpers| apply to it. |mime_type| is null
+  // before response headers are available. Returns false if none does.
+  template <typename Callback>
+  static bool BuildDispatchPlan(const std::vector<Helper<Callback>>& helpers,
+                                const std::string* mime_type,
+                                brave::BraveRequestInfo* ctx);
+
+  std::vector<Helper<brave::OnBeforeURLRequestCallback>>
+      before_url_request_callbacks_;
+  std::vector<Helper<brave::OnBeforeStartTransactionCallback>>
       before_start_transaction_callbacks_;
-  std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
+  std::vector<Helper<brave::OnHeadersReceivedCallback>>
+      headers_received_callbacks_;
 
   // TODO(iefremov): actually, we don't have to keep the list here, since
   // it is global for the whole browser and could live a singletonce in the
   // rewards service. Eliminating this will also help to avoid using
   // PrefChangeRegistrar and corresponding |base::Unretained| usages, that are
   // illegal.
-  std::unique_ptr<base::ListValue> referral_headers_list_;
-  std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  // Compiled once per kReferralHeaders change and shared read-only with the
+  // request contexts, which may outlive a later update.
+  std::shared_ptr<const brave::ReferralHeadersMatcher>
+      referral_headers_matcher_;
+  // Completion callbacks of requests waiting on an asynchronous helper.
+  base::flat_map<uint64_t, net::CompletionOnceCallback> callbacks_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       pref_change_registrar_;
 
@@ -0,0 +1,245 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/path_service.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
+#include "brave/browser/net/brave_request_handler.h"
+#include "brave/browser/net/url_context.h"
+#include "brave/common/brave_paths.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_request_headers.h"
+#include "testing/perf/perf_test.h"
+#include "url/gurl.h"
+
+namespace {
+
+// Passes over the corpus. The first one only warms up lazily built state and
+// isn't measured.
+constexpr int kPasses = 21;
+constexpr char kHelperHistogramPrefix[] = "Brave.NetworkHelper.";
+constexpr int kPercentiles[] = {50, 90, 99};
+
+struct CorpusEntry {
+  blink::mojom::ResourceType resource_type;
+  GURL tab_url;
+  GURL request_url;
+};
+
+bool ParseResourceType(base::StringPiece name,
+                       blink::mojom::ResourceType* type) {
+  static constexpr struct {
+    const char* name;
+    blink::mojom::ResourceType type;
+  } kResourceTypes[] = {
+      {"main_frame", blink::mojom::ResourceType::kMainFrame},
+      {"sub_frame", blink::mojom::ResourceType::kSubFrame},
+      {"stylesheet", blink::mojom::ResourceType::kStylesheet},
+      {"script", blink::mojom::ResourceType::kScript},
+      {"image", blink::mojom::ResourceType::kImage},
+      {"xhr", blink::mojom::ResourceType::kXhr},
+  };
+  for (const auto& resource_type : kResourceTypes) {
+    if (name == resource_type.name) {
+      *type = resource_type.type;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Reads test/data/perf/network_request_corpus.txt, one
+// "<resource type> <tab URL> <request URL>" request per line.
+std::vector<CorpusEntry> LoadCorpus() {
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  base::FilePath corpus_path;
+  base::PathService::Get(brave::DIR_TEST_DATA, &corpus_path);
+  corpus_path = corpus_path.AppendASCII("perf").AppendASCII(
+      "network_request_corpus.txt");
+  std::string contents;
+  if (!base::ReadFileToString(corpus_path, &contents))
+    return {};
+
+  std::vector<CorpusEntry> corpus;
+  for (base::StringPiece line : base::SplitStringPiece(
+           contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (base::StartsWith(line, "#", base::CompareCase::SENSITIVE))
+      continue;
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        line, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    CorpusEntry entry;
+    if (fields.size() != 3 ||
+        !ParseResourceType(fields[0], &entry.resource_type)) {
+      ADD_FAILURE() << "Malformed corpus line: " << line;
+      continue;
+    }
+    entry.tab_url = GURL(fields[1]);
+    entry.request_url = GURL(fields[2]);
+    corpus.push_back(std::move(entry));
+  }
+  return corpus;
+}
+
+// Starts a request stage with the given completion callback and waits for it
+// if it went async. Returns the stage's result.
+int RunStage(base::OnceCallback<int(net::CompletionOnceCallback)> stage) {
+  int result = net::OK;
+  base::RunLoop run_loop;
+  const int rv = std::move(stage).Run(base::BindOnce(
+      [](int* result, base::OnceClosure quit, int rv) {
+        *result = rv;
+        std::move(quit).Run();
+      },
+      &result, run_loop.QuitClosure()));
+  if (rv != net::ERR_IO_PENDING)
+    return rv;
+  run_loop.Run();
+  return result;
+}
+
+// |samples| must be sorted.
+int64_t Percentile(const std::vector<int64_t>& samples, int percent) {
+  return samples[(samples.size() - 1) * percent / 100];
+}
+
+// Histogram buckets only keep a lower bound for their samples, so this is as
+// precise as the bucket layout.
+base::HistogramBase::Sample Percentile(const std::vector<base::Bucket>& buckets,
+                                       int percent) {
+  int64_t total = 0;
+  for (const base::Bucket& bucket : buckets)
+    total += bucket.count;
+  const int64_t rank = std::max<int64_t>(1, (total * percent + 99) / 100);
+  int64_t seen = 0;
+  for (const base::Bucket& bucket : buckets) {
+    seen += bucket.count;
+    if (seen >= rank)
+      return bucket.min;
+  }
+  return buckets.back().min;
+}
+
+void PrintPercentile(const std::string& trace, int percent, int64_t value) {
+  perf_test::PrintResult("brave_request_handler",
+                         "_p" + base::NumberToString(percent), trace,
+                         static_cast<size_t>(value), "us", true);
+}
+
+}  // namespace
+
+class BraveRequestHandlerPerfTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+    brave::RegisterPathProvider();
+    corpus_ = LoadCorpus();
+    ASSERT_FALSE(corpus_.empty());
+    handler_ = std::make_unique<BraveRequestHandler>();
+  }
+
+  void TearDownOnMainThread() override {
+    handler_.reset();
+    InProcessBrowserTest::TearDownOnMainThread();
+  }
+
+ protected:
+  // Sends a request through the stages BraveRequestHandler sees before the
+  // network does, the way BraveProxyingURLLoaderFactory would with shields up.
+  void ReplayRequest(const CorpusEntry& entry) {
+    auto ctx = std::make_shared<brave::BraveRequestInfo>();
+    ctx->request_identifier = ++last_request_identifier_;
+    ctx->request_url = entry.request_url;
+    ctx->tab_url = entry.tab_url;
+    ctx->tab_origin = entry.tab_url.GetOrigin();
+    if (entry.resource_type != blink::mojom::ResourceType::kMainFrame)
+      ctx->initiator_url = ctx->tab_origin;
+    ctx->resource_type = entry.resource_type;
+
+    GURL new_url;
+    const int rv = RunStage(base::BindOnce(
+        [](BraveRequestHandler* handler,
+           std::shared_ptr<brave::BraveRequestInfo> ctx, GURL* new_url,
+           net::CompletionOnceCallback callback) {
+          return handler->OnBeforeURLRequest(ctx, std::move(callback),
+                                             new_url);
+        },
+        handler_.get(), ctx, &new_url));
+
+    if (rv == net::OK) {
+      auto next_ctx = brave::BraveRequestInfo::MakeCTXForNextStage(*ctx);
+      net::HttpRequestHeaders headers;
+      RunStage(base::BindOnce(
+          [](BraveRequestHandler* handler,
+             std::shared_ptr<brave::BraveRequestInfo> ctx,
+             net::HttpRequestHeaders* headers,
+             net::CompletionOnceCallback callback) {
+            return handler->OnBeforeStartTransaction(
+                ctx, std::move(callback), headers);
+          },
+          handler_.get(), next_ctx, &headers));
+    }
+    handler_->OnURLRequestDestroyed(ctx);
+  }
+
+  std::vector<CorpusEntry> corpus_;
+  std::unique_ptr<BraveRequestHandler> handler_;
+  uint64_t last_request_identifier_ = 0;
+};
+
+// Per-helper numbers come from the Brave.NetworkHelper.* histograms, which
+// time the synchronous part of each helper. The total also covers waiting
+// for helpers that went async.
+IN_PROC_BROWSER_TEST_F(BraveRequestHandlerPerfTest, ReplayCorpus) {
+  for (const CorpusEntry& entry : corpus_)
+    ReplayRequest(entry);
+
+  base::HistogramTester histogram_tester;
+  std::vector<int64_t> totals;
+  for (int pass = 1; pass < kPasses; ++pass) {
+    for (const CorpusEntry& entry : corpus_) {
+      const base::TimeTicks start = base::TimeTicks::Now();
+      ReplayRequest(entry);
+      totals.push_back((base::TimeTicks::Now() - start).InMicroseconds());
+    }
+  }
+
+  std::sort(totals.begin(), totals.end());
+  for (int percent : kPercentiles)
+    PrintPercentile("total", percent, Percentile(totals, percent));
+
+  for (const base::HistogramBase* histogram :
+       base::StatisticsRecorder::GetHistograms()) {
+    const std::string name = histogram->histogram_name();
+    if (!base::StartsWith(name, kHelperHistogramPrefix,
+                          base::CompareCase::SENSITIVE)) {
+      continue;
+    }
+    const std::vector<base::Bucket> buckets =
+        histogram_tester.GetAllSamples(name);
+    if (buckets.empty())
+      continue;
+    const std::string helper = name.substr(strlen(kHelperHistogramPrefix));
+    for (int percent : kPercentiles)
+      PrintPercentile(helper, percent, Percentile(buckets, percent));
+  }
+}
@@ -5,6 +5,9 @@
 
 #include "brave/browser/net/brave_stp_util.h"
 
+#include <string>
+#include <unordered_set>
+
 #include "base/no_destructor.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 
@@ -19,15 +22,30 @@ base::flat_set<base::StringPiece>* TrackableSecurityHeaders() {
 }
 
 void RemoveTrackableSecurityHeadersForThirdParty(
-    const GURL& request_url, const url::Origin& top_frame_origin,
+    const GURL& request_url, const GURL& tab_origin,
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers) {
-  if (!original_response_headers && !override_response_headers->get()) {
+  const net::HttpResponseHeaders* headers =
+      override_response_headers->get() ? override_response_headers->get()
+                                       : original_response_headers;
+  if (!headers) {
+    return;
+  }
+
+  // Most responses carry none of these, so look before doing the
+  // registry-controlled domain lookup or copying the headers.
+  std::unordered_set<std::string> present_headers;
+  for (auto header : *TrackableSecurityHeaders()) {
+    if (headers->HasHeader(header)) {
+      present_headers.insert(header.as_string());
+    }
+  }
+  if (present_headers.empty()) {
     return;
   }
 
   if (net::registry_controlled_domains::SameDomainOrHost(
-          request_url, top_frame_origin,
+          request_url, tab_origin,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
     return;
   }
@@ -36,9 +54,7 @@ void RemoveTrackableSecurityHeadersForThirdParty(
     *override_response_headers =
         new net::HttpResponseHeaders(original_response_headers->raw_headers());
   }
-  for (auto header : *TrackableSecurityHeaders()) {
-    (*override_response_headers)->RemoveHeader(header.as_string());
-  }
+  (*override_response_headers)->RemoveHeaders(present_headers);
 }
 
 }  // namespace brave
@@ -10,14 +10,16 @@
 #include "base/strings/string_piece.h"
 #include "net/http/http_response_headers.h"
 #include "url/gurl.h"
-#include "url/origin.h"
 
 namespace brave {
 
 base::flat_set<base::StringPiece>* TrackableSecurityHeaders();
 
+// Strips the headers above from responses to requests that are third-party
+// to |tab_origin|. |override_response_headers| is only created when there is
+// something to remove.
 void RemoveTrackableSecurityHeadersForThirdParty(
-    const GURL& request_url, const url::Origin& top_frame_origin,
+    const GURL& request_url, const GURL& tab_origin,
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers);
 
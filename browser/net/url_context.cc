@@ -7,13 +7,17 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
-#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "base/stl_util.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
+#include "url/url_constants.h"
 
 namespace brave {
 
@@ -50,6 +54,7 @@ void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
                                content::BrowserContext* browser_context,
                                std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  TRACE_EVENT0("browser", "BraveRequestInfo::FillCTX");
   ctx->request_identifier = request_identifier;
   ctx->request_url = request.url;
   // TODO(iefremov): Replace GURL with Origin
@@ -96,16 +101,84 @@ void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
                               .GetOrigin();
   }
 
-  Profile* profile = Profile::FromBrowserContext(browser_context);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(profile, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(profile, ctx->tab_origin) ==
-                   brave_shields::ControlType::ALLOW;
+  const brave_shields::ShieldsSettings settings =
+      brave_shields::ShieldsSettingsCache::GetForProfile(
+          Profile::FromBrowserContext(browser_context))
+          ->Get(ctx->tab_origin);
+  ctx->allow_brave_shields = settings.shields_enabled;
+  ctx->allow_ads = settings.allow_ads;
   ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(profile, ctx->tab_origin);
-  ctx->allow_referrers =
-      brave_shields::AllowReferrers(profile, ctx->tab_origin);
+      settings.allow_http_upgradable_resource;
+  ctx->allow_referrers = settings.allow_referrers;
   ctx->upload_data = GetUploadData(request);
 }
 
+// static
+std::shared_ptr<BraveRequestInfo> BraveRequestInfo::MakeCTXForNextStage(
+    const BraveRequestInfo& previous) {
+  auto ctx = std::make_shared<BraveRequestInfo>();
+  ctx->request_identifier = previous.request_identifier;
+  ctx->request_url = previous.request_url;
+  ctx->initiator_url = previous.initiator_url;
+  ctx->referrer = previous.referrer;
+  ctx->referrer_policy = previous.referrer_policy;
+  ctx->resource_type = previous.resource_type;
+  ctx->is_webtorrent_disabled = previous.is_webtorrent_disabled;
+  ctx->render_frame_id = previous.render_frame_id;
+  ctx->render_process_id = previous.render_process_id;
+  ctx->frame_tree_node_id = previous.frame_tree_node_id;
+  ctx->tab_origin = previous.tab_origin;
+  ctx->tab_url = previous.tab_url;
+  ctx->allow_brave_shields = previous.allow_brave_shields;
+  ctx->allow_ads = previous.allow_ads;
+  ctx->allow_http_upgradable_resource =
+      previous.allow_http_upgradable_resource;
+  ctx->allow_referrers = previous.allow_referrers;
+  ctx->upload_data = previous.upload_data;
+  return ctx;
+}
+
+HelperFilter::HelperFilter() = default;
+
+HelperFilter::HelperFilter(const char* name) : name(name) {}
+
+HelperFilter::HelperFilter(const HelperFilter& other) = default;
+
+HelperFilter::~HelperFilter() = default;
+
+// static
+uint32_t HelperFilter::SchemeBit(const GURL& url) {
+  if (url.SchemeIs(url::kHttpsScheme))
+    return kHttps;
+  if (url.SchemeIs(url::kHttpScheme))
+    return kHttp;
+  if (url.SchemeIs(url::kWssScheme))
+    return kWss;
+  if (url.SchemeIs(url::kWsScheme))
+    return kWs;
+  return kOtherSchemes;
+}
+
+// static
+uint32_t HelperFilter::ResourceTypeBit(
+    blink::mojom::ResourceType resource_type) {
+  const int value = static_cast<int>(resource_type);
+  if (value < 0 || value >= 32)
+    return 0;
+  return 1u << value;
+}
+
+bool HelperFilter::MatchesRequest(const BraveRequestInfo& ctx) const {
+  if (requires_tab_origin && ctx.tab_origin.is_empty())
+    return false;
+  if (schemes != kAllSchemes && !(schemes & SchemeBit(ctx.request_url)))
+    return false;
+  return resource_types == kAllResourceTypes ||
+         (resource_types & ResourceTypeBit(ctx.resource_type));
+}
+
+bool HelperFilter::MatchesResponse(const std::string& mime_type) const {
+  return mime_types.empty() || base::Contains(mime_types, mime_type);
+}
+
 }  // namespace brave
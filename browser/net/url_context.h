@@ -9,6 +9,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "net/url_request/url_request.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
@@ -25,6 +26,7 @@ struct ResourceRequest;
 }
 
 namespace brave {
+class ReferralHeadersMatcher;
 struct BraveRequestInfo;
 using ResponseCallback = base::Callback<void()>;
 }  // namespace brave
@@ -87,7 +89,7 @@ struct BraveRequestInfo {
 
   GURL* allowed_unsafe_redirect_url = nullptr;
   BraveNetworkDelegateEventType event_type = kUnknownEventType;
-  const base::ListValue* referral_headers_list = nullptr;
+  std::shared_ptr<const ReferralHeadersMatcher> referral_headers_matcher;
   BlockedBy blocked_by = kNotBlocked;
   bool cancel_request_explicitly = false;
   std::string mock_data_url;
@@ -109,12 +111,21 @@ struct BraveRequestInfo {
                       content::BrowserContext* browser_context,
                       std::shared_ptr<brave::BraveRequestInfo> ctx);
 
+  // Starts a context for the next stage of the same request, reusing the
+  // request and shields data |previous| got from FillCTX instead of looking
+  // them up again. Per-stage results are not carried over.
+  static std::shared_ptr<BraveRequestInfo> MakeCTXForNextStage(
+      const BraveRequestInfo& previous);
+
  private:
   // Please don't add any more friends here if it can be avoided.
   // We should also remove the one below.
   friend class ::BraveRequestHandler;
 
   GURL* new_url = nullptr;
+  // Bit i is set if the i-th helper of the current stage applies to this
+  // request.
+  uint32_t dispatch_plan = 0;
 
   DISALLOW_COPY_AND_ASSIGN(BraveRequestInfo);
 };
@@ -134,6 +145,45 @@ using OnHeadersReceivedCallback = base::Callback<int(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx)>;
 
+// Describes which requests a network helper can act on, so that
+// BraveRequestHandler can leave it out of a request's dispatch plan instead
+// of calling it only for the helper to bail out. Helpers still do their own
+// checks; a filter only has to be a superset of what the helper handles.
+// The event type is given by the stage the helper is registered for.
+struct HelperFilter {
+  // Bits of |schemes|.
+  enum Scheme : uint32_t {
+    kHttp = 1 << 0,
+    kHttps = 1 << 1,
+    kWs = 1 << 2,
+    kWss = 1 << 3,
+    kOtherSchemes = 1 << 4,
+  };
+  static constexpr uint32_t kAllSchemes = ~0u;
+  static constexpr uint32_t kAllResourceTypes = ~0u;
+
+  HelperFilter();
+  explicit HelperFilter(const char* name);
+  HelperFilter(const HelperFilter& other);
+  ~HelperFilter();
+
+  static uint32_t SchemeBit(const GURL& url);
+  static uint32_t ResourceTypeBit(blink::mojom::ResourceType resource_type);
+
+  bool MatchesRequest(const BraveRequestInfo& ctx) const;
+  // |mime_type| is the lowercase MIME type of the response, if it has one.
+  bool MatchesResponse(const std::string& mime_type) const;
+
+  // Used to name the helper's timing histogram.
+  const char* name = "";
+  uint32_t schemes = kAllSchemes;
+  // Bits from ResourceTypeBit().
+  uint32_t resource_types = kAllResourceTypes;
+  bool requires_tab_origin = false;
+  // OnHeadersReceived only. Empty matches any response.
+  std::vector<std::string> mime_types;
+};
+
 }  // namespace brave
 
 #endif  // BRAVE_BROWSER_NET_URL_CONTEXT_H_
@@ -0,0 +1,57 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_context.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+#include "url/gurl.h"
+
+using brave::BraveRequestInfo;
+using brave::HelperFilter;
+
+TEST(HelperFilterTest, DefaultMatchesEverything) {
+  const HelperFilter filter("Test");
+
+  BraveRequestInfo request_info(GURL("chrome-extension://abc/index.html"));
+  EXPECT_TRUE(filter.MatchesRequest(request_info));
+  EXPECT_TRUE(filter.MatchesResponse(""));
+  EXPECT_TRUE(filter.MatchesResponse("text/html"));
+}
+
+TEST(HelperFilterTest, MatchesSchemes) {
+  HelperFilter filter("Test");
+  filter.schemes = HelperFilter::kHttp | HelperFilter::kHttps;
+
+  EXPECT_TRUE(filter.MatchesRequest(BraveRequestInfo(GURL("http://a.com/"))));
+  EXPECT_TRUE(filter.MatchesRequest(BraveRequestInfo(GURL("https://a.com/"))));
+  EXPECT_FALSE(filter.MatchesRequest(BraveRequestInfo(GURL("wss://a.com/"))));
+  EXPECT_FALSE(filter.MatchesRequest(BraveRequestInfo(GURL("ftp://a.com/"))));
+
+  filter.schemes = HelperFilter::kWs | HelperFilter::kWss;
+  EXPECT_TRUE(filter.MatchesRequest(BraveRequestInfo(GURL("ws://a.com/"))));
+  EXPECT_FALSE(filter.MatchesRequest(BraveRequestInfo(GURL("https://a.com/"))));
+}
+
+TEST(HelperFilterTest, MatchesResourceTypesAndTabOrigin) {
+  HelperFilter filter("Test");
+  filter.resource_types =
+      HelperFilter::ResourceTypeBit(blink::mojom::ResourceType::kScript) |
+      HelperFilter::ResourceTypeBit(blink::mojom::ResourceType::kImage);
+  filter.requires_tab_origin = true;
+
+  BraveRequestInfo request_info(GURL("https://a.com/script.js"));
+  request_info.resource_type = blink::mojom::ResourceType::kScript;
+  EXPECT_FALSE(filter.MatchesRequest(request_info));
+
+  request_info.tab_origin = GURL("https://b.com/");
+  EXPECT_TRUE(filter.MatchesRequest(request_info));
+
+  request_info.resource_type = blink::mojom::ResourceType::kMainFrame;
+  EXPECT_FALSE(filter.MatchesRequest(request_info));
+
+  request_info.resource_type = BraveRequestInfo::kInvalidResourceType;
+  EXPECT_FALSE(filter.MatchesRequest(request_info));
+}
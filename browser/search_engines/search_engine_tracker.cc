@@ -5,14 +5,31 @@
 
 #include "brave/browser/search_engines/search_engine_tracker.h"
 
+#include <algorithm>
+
 #include "base/metrics/histogram_macros.h"
+#include "base/stl_util.h"
 #include "base/strings/string_util.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/search_engines/template_url_service_factory.h"
 #include "components/keyed_service/content/browser_context_dependency_manager.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
 
 namespace {
 
+constexpr char kSearchCountPrefName[] = "brave.weekly_storage.search_count";
+
+void RecordSearchEventP3A(uint64_t number_of_searches) {
+  constexpr int kIntervals[] = {0, 5, 10, 20, 50, 100, 500};
+  const int* it =
+      std::lower_bound(kIntervals, std::end(kIntervals), number_of_searches);
+  const int answer = it - kIntervals;
+  UMA_HISTOGRAM_EXACT_LINEAR("Brave.Omnibox.SearchCount", answer,
+                             base::size(kIntervals));
+}
+
 // Deduces the search engine from |type|, if nothing is found - from |url|.
 // Not all engines added by Brave are present in |SearchEngineType| enumeration.
 void RecordSearchEngineP3A(const GURL& search_engine_url,
@@ -44,6 +61,13 @@ SearchEngineTrackerFactory* SearchEngineTrackerFactory::GetInstance() {
   return base::Singleton<SearchEngineTrackerFactory>::get();
 }
 
+// static
+SearchEngineTracker* SearchEngineTrackerFactory::GetForBrowserContext(
+    content::BrowserContext* context) {
+  return static_cast<SearchEngineTracker*>(
+      GetInstance()->GetServiceForBrowserContext(context, true /*create*/));
+}
+
 SearchEngineTrackerFactory::SearchEngineTrackerFactory()
     : BrowserContextKeyedServiceFactory(
           "SearchEngineTracker",
@@ -55,10 +79,11 @@ SearchEngineTrackerFactory::~SearchEngineTrackerFactory() {}
 
 KeyedService* SearchEngineTrackerFactory::BuildServiceInstanceFor(
     content::BrowserContext* context) const {
-  auto* template_url_service = TemplateURLServiceFactory::GetForProfile(
-      Profile::FromBrowserContext(context));
+  Profile* profile = Profile::FromBrowserContext(context);
+  auto* template_url_service =
+      TemplateURLServiceFactory::GetForProfile(profile);
   if (template_url_service) {
-    return new SearchEngineTracker(template_url_service);
+    return new SearchEngineTracker(template_url_service, profile->GetPrefs());
   }
   return nullptr;
 }
@@ -68,8 +93,11 @@ bool SearchEngineTrackerFactory::ServiceIsCreatedWithBrowserContext() const {
 }
 
 SearchEngineTracker::SearchEngineTracker(
-    TemplateURLService* template_url_service)
-    : template_url_service_(template_url_service) {
+    TemplateURLService* template_url_service,
+    PrefService* user_prefs)
+    : template_url_service_(template_url_service),
+      search_count_storage_(
+          std::make_unique<WeeklyStorage>(user_prefs, kSearchCountPrefName)) {
   observer_.Add(template_url_service_);
   const TemplateURL* template_url =
       template_url_service_->GetDefaultSearchProvider();
@@ -85,10 +113,33 @@ SearchEngineTracker::SearchEngineTracker(
       RecordSearchEngineP3A(url, template_url->GetEngineType(search_terms));
     }
   }
+
+  // Record initial search count p3a value.
+  if (user_prefs->GetList(kSearchCountPrefName)->GetList().empty()) {
+    RecordSearchEventP3A(0);
+  }
 }
 
 SearchEngineTracker::~SearchEngineTracker() {}
 
+// static
+void SearchEngineTracker::RegisterProfilePrefs(PrefRegistrySimple* registry) {
+  registry->RegisterListPref(kSearchCountPrefName);
+}
+
+void SearchEngineTracker::RecordSearchEvent() {
+  if (!search_count_storage_) {
+    return;
+  }
+  search_count_storage_->AddDelta(1);
+  RecordSearchEventP3A(search_count_storage_->GetWeeklySum());
+}
+
+void SearchEngineTracker::Shutdown() {
+  // Writes the pending search count while prefs are still around.
+  search_count_storage_.reset();
+}
+
 void SearchEngineTracker::OnTemplateURLServiceChanged() {
   const TemplateURL* template_url =
       template_url_service_->GetDefaultSearchProvider();
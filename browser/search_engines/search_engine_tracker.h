@@ -6,6 +6,8 @@
 #ifndef BRAVE_BROWSER_SEARCH_ENGINES_SEARCH_ENGINE_TRACKER_H_
 #define BRAVE_BROWSER_SEARCH_ENGINES_SEARCH_ENGINE_TRACKER_H_
 
+#include <memory>
+
 #include "base/memory/singleton.h"
 #include "base/scoped_observer.h"
 #include "components/keyed_service/content/browser_context_keyed_service_factory.h"
@@ -15,6 +17,11 @@
 #include "components/search_engines/template_url_service_observer.h"
 #include "url/gurl.h"
 
+class PrefRegistrySimple;
+class PrefService;
+class SearchEngineTracker;
+class WeeklyStorage;
+
 // Exposed for tests.
 constexpr char kDefaultSearchEngineMetric[] = "Brave.Search.DefaultEngine";
 
@@ -33,6 +40,8 @@ enum class SearchEngineP3A {
 class SearchEngineTrackerFactory : public BrowserContextKeyedServiceFactory {
  public:
   static SearchEngineTrackerFactory* GetInstance();
+  static SearchEngineTracker* GetForBrowserContext(
+      content::BrowserContext* context);
 
  private:
   friend struct base::DefaultSingletonTraits<SearchEngineTrackerFactory>;
@@ -49,16 +58,25 @@ class SearchEngineTrackerFactory : public BrowserContextKeyedServiceFactory {
   bool ServiceIsCreatedWithBrowserContext() const override;
 };
 
-// Records P3A metrics when default search engine changes.
+// Records P3A metrics when default search engine changes and counts the
+// searches made from the omnibox over the last week.
 class SearchEngineTracker : public KeyedService,
                             public TemplateURLServiceObserver {
  public:
-  explicit SearchEngineTracker(TemplateURLService* template_url_service);
+  SearchEngineTracker(TemplateURLService* template_url_service,
+                      PrefService* user_prefs);
   ~SearchEngineTracker() override;
 
   SearchEngineTracker(const SearchEngineTracker&) = delete;
   SearchEngineTracker& operator=(const SearchEngineTracker&) = delete;
 
+  static void RegisterProfilePrefs(PrefRegistrySimple* registry);
+
+  void RecordSearchEvent();
+
+  // KeyedService:
+  void Shutdown() override;
+
  private:
   // TemplateURLServiceObserver overrides:
   void OnTemplateURLServiceChanged() override;
@@ -70,6 +88,8 @@ class SearchEngineTracker : public KeyedService,
   GURL default_search_url_;
 
   TemplateURLService* template_url_service_;
+
+  std::unique_ptr<WeeklyStorage> search_count_storage_;
 };
 
 #endif  // BRAVE_BROWSER_SEARCH_ENGINES_SEARCH_ENGINE_TRACKER_H_
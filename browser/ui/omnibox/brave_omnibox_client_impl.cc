@@ -5,25 +5,17 @@
 
 #include "brave/browser/ui/omnibox/brave_omnibox_client_impl.h"
 
-#include <algorithm>
-
-#include "base/metrics/histogram_macros.h"
-#include "base/stl_util.h"
-#include "base/values.h"
 #include "brave/browser/autocomplete/brave_autocomplete_scheme_classifier.h"
+#include "brave/browser/search_engines/search_engine_tracker.h"
 #include "brave/common/pref_names.h"
-#include "brave/components/weekly_storage/weekly_storage.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_client.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_edit_controller.h"
 #include "components/omnibox/browser/autocomplete_match.h"
-#include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 
 namespace {
 
-constexpr char kSearchCountPrefName[] = "brave.weekly_storage.search_count";
-
 bool IsSearchEvent(const AutocompleteMatch& match) {
   switch (match.type) {
     case AutocompleteMatchType::SEARCH_WHAT_YOU_TYPED:
@@ -41,15 +33,6 @@ bool IsSearchEvent(const AutocompleteMatch& match) {
   return false;
 }
 
-void RecordSearchEventP3A(uint64_t number_of_searches) {
-  constexpr int kIntervals[] = {0, 5, 10, 20, 50, 100, 500};
-  const int* it =
-      std::lower_bound(kIntervals, std::end(kIntervals), number_of_searches);
-  const int answer = it - kIntervals;
-  UMA_HISTOGRAM_EXACT_LINEAR("Brave.Omnibox.SearchCount", answer,
-                             base::size(kIntervals));
-}
-
 }  // namespace
 
 BraveOmniboxClientImpl::BraveOmniboxClientImpl(
@@ -57,21 +40,10 @@ BraveOmniboxClientImpl::BraveOmniboxClientImpl(
     Profile* profile)
     : ChromeOmniboxClient(controller, profile),
       profile_(profile),
-      scheme_classifier_(profile) {
-  // Record initial search count p3a value.
-  const base::Value* search_p3a =
-      profile_->GetPrefs()->GetList(kSearchCountPrefName);
-  if (search_p3a->GetList().size() == 0) {
-    RecordSearchEventP3A(0);
-  }
-}
+      scheme_classifier_(profile) {}
 
 BraveOmniboxClientImpl::~BraveOmniboxClientImpl() {}
 
-void BraveOmniboxClientImpl::RegisterPrefs(PrefRegistrySimple* registry) {
-  registry->RegisterListPref(kSearchCountPrefName);
-}
-
 const AutocompleteSchemeClassifier&
 BraveOmniboxClientImpl::GetSchemeClassifier() const {
   return scheme_classifier_;
@@ -82,10 +54,11 @@ bool BraveOmniboxClientImpl::IsAutocompleteEnabled() const {
 }
 
 void BraveOmniboxClientImpl::OnInputAccepted(const AutocompleteMatch& match) {
-  if (IsSearchEvent(match)) {
-    // TODO(iefremov): Optimize this.
-    WeeklyStorage storage(profile_->GetPrefs(), kSearchCountPrefName);
-    storage.AddDelta(1);
-    RecordSearchEventP3A(storage.GetWeeklySum());
-  }
+  if (!IsSearchEvent(match))
+    return;
+  // Off the record searches are counted too, as they always were.
+  auto* tracker = SearchEngineTrackerFactory::GetForBrowserContext(
+      profile_->GetOriginalProfile());
+  if (tracker)
+    tracker->RecordSearchEvent();
 }
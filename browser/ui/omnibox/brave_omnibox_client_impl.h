@@ -10,7 +10,6 @@
 #include "chrome/browser/ui/omnibox/chrome_omnibox_client.h"
 
 class OmniboxEditController;
-class PrefRegistrySimple;
 class Profile;
 
 class BraveOmniboxClientImpl : public ChromeOmniboxClient {
@@ -18,8 +17,6 @@ class BraveOmniboxClientImpl : public ChromeOmniboxClient {
   BraveOmniboxClientImpl(OmniboxEditController* controller, Profile* profile);
   ~BraveOmniboxClientImpl() override;
 
-  static void RegisterPrefs(PrefRegistrySimple* prefs);
-
   const AutocompleteSchemeClassifier& GetSchemeClassifier() const override;
   bool IsAutocompleteEnabled() const override;
 
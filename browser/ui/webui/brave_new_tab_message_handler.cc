@@ -9,6 +9,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/json/json_writer.h"
 #include "base/values.h"
 #include "brave/browser/profiles/profile_util.h"
@@ -40,6 +41,11 @@ using ntp_background_images::ViewCounterServiceFactory;
 
 namespace {
 
+// Stats counters can change hundreds of times a second while browsing, the
+// page doesn't need to hear about them more often than it can paint.
+constexpr base::TimeDelta kStatsUpdateDelay =
+    base::TimeDelta::FromMilliseconds(16);
+
 bool IsPrivateNewTab(Profile* profile) {
   return brave::IsTorProfile(profile) ||
          profile->IsIncognitoProfile() ||
@@ -256,6 +262,8 @@ void BraveNewTabMessageHandler::OnJavascriptAllowed() {
 
 void BraveNewTabMessageHandler::OnJavascriptDisallowed() {
   pref_change_registrar_.RemoveAll();
+  stats_update_timer_.Stop();
+  last_sent_stats_ = base::Value();
 }
 
 void BraveNewTabMessageHandler::HandleGetPreferences(
@@ -270,6 +278,7 @@ void BraveNewTabMessageHandler::HandleGetStats(const base::ListValue* args) {
   AllowJavascript();
   PrefService* prefs = profile_->GetPrefs();
   auto data = GetStatsDictionary(prefs);
+  last_sent_stats_ = data.Clone();
   ResolveJavascriptCallback(args->GetList()[0], data);
 }
 
@@ -368,9 +377,33 @@ void BraveNewTabMessageHandler::OnPrivatePropertiesChanged() {
 }
 
 void BraveNewTabMessageHandler::OnStatsChanged() {
+  if (stats_update_timer_.IsRunning())
+    return;
+  stats_update_timer_.Start(
+      FROM_HERE, kStatsUpdateDelay,
+      base::BindOnce(&BraveNewTabMessageHandler::SendStatsUpdate,
+                     base::Unretained(this)));
+}
+
+void BraveNewTabMessageHandler::SendStatsUpdate() {
   PrefService* prefs = profile_->GetPrefs();
   auto data = GetStatsDictionary(prefs);
-  FireWebUIListener("stats-updated", data);
+
+  // Only send the stats which changed since the page last heard from us,
+  // the page merges them into what it already has.
+  base::DictionaryValue delta;
+  for (const auto& stat : data.DictItems()) {
+    const base::Value* last_value =
+        last_sent_stats_.is_dict() ? last_sent_stats_.FindKey(stat.first)
+                                   : nullptr;
+    if (!last_value || *last_value != stat.second)
+      delta.SetKey(stat.first, stat.second.Clone());
+  }
+  if (delta.DictEmpty())
+    return;
+
+  last_sent_stats_ = std::move(data);
+  FireWebUIListener("stats-updated", delta);
 }
 
 void BraveNewTabMessageHandler::OnPreferencesChanged() {
@@ -6,6 +6,8 @@
 #ifndef BRAVE_BROWSER_UI_WEBUI_BRAVE_NEW_TAB_MESSAGE_HANDLER_H_
 #define BRAVE_BROWSER_UI_WEBUI_BRAVE_NEW_TAB_MESSAGE_HANDLER_H_
 
+#include "base/timer/timer.h"
+#include "base/values.h"
 #include "components/prefs/pref_change_registrar.h"
 #include "content/public/browser/web_ui_message_handler.h"
 
@@ -40,10 +42,15 @@ class BraveNewTabMessageHandler : public content::WebUIMessageHandler {
   void HandleGetDefaultSuperReferralTopSitesData(const base::ListValue* args);
 
   void OnStatsChanged();
+  void SendStatsUpdate();
   void OnPreferencesChanged();
   void OnPrivatePropertiesChanged();
 
   PrefChangeRegistrar pref_change_registrar_;
+  // Coalesces bursts of stats pref changes into one update per frame.
+  base::OneShotTimer stats_update_timer_;
+  // Stats as last sent to the page, so updates only carry changed values.
+  base::Value last_sent_stats_;
   // Weak pointer.
   Profile* profile_;
 
@@ -6,10 +6,13 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 
+// |brave_rules_revision| is unique per set of rules received by a renderer
+// and 0 for rules that were never deserialized.
 #define BRAVE_CONTENT_SETTINGS_H                  \
   ContentSettingsForOneType autoplay_rules;       \
   ContentSettingsForOneType fingerprinting_rules; \
-  ContentSettingsForOneType brave_shields_rules;
+  ContentSettingsForOneType brave_shields_rules;  \
+  uint64_t brave_rules_revision = 0;
 
 #include "../../../../../../components/content_settings/core/common/content_settings.h"
 
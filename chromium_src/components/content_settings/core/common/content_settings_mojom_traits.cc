@@ -3,10 +3,24 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
-#define BRAVE_READ_RENDERER_CONTENT_SETTING_RULES_DATA_VIEW       \
-  data.ReadAutoplayRules(&out->autoplay_rules) &&                 \
-      data.ReadFingerprintingRules(&out->fingerprinting_rules) && \
-      data.ReadBraveShieldsRules(&out->brave_shields_rules) &&
+#include <atomic>
+
+namespace {
+
+// Lets renderers tell apart rule updates cheaply, so that derived lookup
+// structures are only rebuilt when new rules arrive.
+uint64_t GetNextBraveRulesRevision() {
+  static std::atomic<uint64_t> revision(0);
+  return ++revision;
+}
+
+}  // namespace
+
+#define BRAVE_READ_RENDERER_CONTENT_SETTING_RULES_DATA_VIEW                  \
+  data.ReadAutoplayRules(&out->autoplay_rules) &&                            \
+      data.ReadFingerprintingRules(&out->fingerprinting_rules) &&            \
+      data.ReadBraveShieldsRules(&out->brave_shields_rules) &&               \
+      (out->brave_rules_revision = GetNextBraveRulesRevision(), true) &&
 
 #include "../../../../../components/content_settings/core/common/content_settings_mojom_traits.cc"  // NOLINT
 
@@ -37,7 +37,8 @@ bool StandardiseFeatsNoOutliers(
 
 }  // namespace
 
-double LinregPredictVector(const std::array<double, feature_count>& features) {
+double LinregPredictVector(base::span<const double> features) {
+  DCHECK_EQ(features.size(), static_cast<size_t>(feature_count));
   // Standardise numeric features
   std::array<double, standardise_feat_count> numeric_features;
   std::copy(features.begin(), features.begin() + standardise_feat_count,
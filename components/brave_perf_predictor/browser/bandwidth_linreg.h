@@ -10,7 +10,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
-#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
+#include "base/containers/span.h"
 
 namespace brave_perf_predictor {
 
@@ -21,7 +21,7 @@ constexpr double kSavingsAbsoluteOutlier = 20 << 20;
 // Computes prediction based on the provided feature vector.
 // It is the client's responsibility to provide features in
 // the exact order expected by the predictor.
-double LinregPredictVector(const std::array<double, feature_count>& features);
+double LinregPredictVector(base::span<const double> features);
 
 // Computes prediction based on key-value map of features.
 // It translates the map to a feature vector internally, and
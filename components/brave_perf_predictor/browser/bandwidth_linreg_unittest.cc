@@ -5,7 +5,10 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 
+#include <array>
+
 #include "base/containers/flat_map.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_perf_predictor {
@@ -5,54 +5,183 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <utility>
+#include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_util.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom.h"
 
 namespace brave_perf_predictor {
 
+namespace {
+
+constexpr base::StringPiece kThirdPartyFeaturePrefix("thirdParties.");
+constexpr base::StringPiece kThirdPartyFeatureSuffix(".blocked");
+
+// Index of the feature |name| in |feature_sequence|, or |feature_count| if the
+// model doesn't use it.
+size_t FeatureIndex(base::StringPiece name) {
+  return std::find(feature_sequence.begin(), feature_sequence.end(), name) -
+         feature_sequence.begin();
+}
+
+enum ResourceType {
+  kDocument,
+  kStylesheet,
+  kScript,
+  kImage,
+  kFont,
+  kMedia,
+  kOther,
+  kResourceTypeCount
+};
+
+constexpr const char* kResourceTypeNames[kResourceTypeCount] = {
+    "document", "stylesheet", "script", "image", "font", "media", "other"};
+
+ResourceType GetResourceType(network::mojom::RequestDestination destination) {
+  switch (destination) {
+    case network::mojom::RequestDestination::kDocument:
+    case network::mojom::RequestDestination::kIframe:
+      return kDocument;
+    case network::mojom::RequestDestination::kStyle:
+      return kStylesheet;
+    case network::mojom::RequestDestination::kScript:
+      return kScript;
+    case network::mojom::RequestDestination::kImage:
+      return kImage;
+    case network::mojom::RequestDestination::kFont:
+      return kFont;
+    case network::mojom::RequestDestination::kAudio:
+    case network::mojom::RequestDestination::kTrack:
+    case network::mojom::RequestDestination::kVideo:
+      return kMedia;
+    default:
+      return kOther;
+  }
+}
+
+// Positions of the model features in the feature vector, resolved once so
+// that accumulating a feature doesn't involve any string handling.
+struct FeatureIndices {
+  FeatureIndices()
+      : adblock_requests(FeatureIndex("adblockRequests")),
+        first_meaningful_paint(FeatureIndex("metrics.firstMeaningfulPaint")),
+        dom_content_loaded(FeatureIndex("metrics.observedDomContentLoaded")),
+        first_visual_change(FeatureIndex("metrics.observedFirstVisualChange")),
+        load(FeatureIndex("metrics.observedLoad")),
+        third_party_request_count(
+            FeatureIndex("resources.third-party.requestCount")),
+        third_party_size(FeatureIndex("resources.third-party.size")),
+        total_request_count(FeatureIndex("resources.total.requestCount")),
+        total_size(FeatureIndex("resources.total.size")) {
+    for (int type = 0; type < kResourceTypeCount; ++type) {
+      const std::string prefix =
+          std::string("resources.") + kResourceTypeNames[type];
+      request_count[type] = FeatureIndex(prefix + ".requestCount");
+      size[type] = FeatureIndex(prefix + ".size");
+    }
+
+    std::vector<std::pair<std::string, size_t>> entities;
+    for (size_t i = 0; i < feature_sequence.size(); ++i) {
+      const base::StringPiece feature(feature_sequence[i]);
+      if (base::StartsWith(feature, kThirdPartyFeaturePrefix,
+                           base::CompareCase::SENSITIVE) &&
+          base::EndsWith(feature, kThirdPartyFeatureSuffix,
+                         base::CompareCase::SENSITIVE)) {
+        entities.emplace_back(
+            feature
+                .substr(kThirdPartyFeaturePrefix.size(),
+                        feature.size() - kThirdPartyFeaturePrefix.size() -
+                            kThirdPartyFeatureSuffix.size())
+                .as_string(),
+            i);
+      }
+    }
+    entity_blocked = base::flat_map<std::string, size_t, std::less<>>(
+        std::move(entities));
+  }
+
+  const size_t adblock_requests;
+  const size_t first_meaningful_paint;
+  const size_t dom_content_loaded;
+  const size_t first_visual_change;
+  const size_t load;
+  const size_t third_party_request_count;
+  const size_t third_party_size;
+  const size_t total_request_count;
+  const size_t total_size;
+  size_t request_count[kResourceTypeCount];
+  size_t size[kResourceTypeCount];
+  // Third-party entity name -> index of its ".blocked" feature.
+  base::flat_map<std::string, size_t, std::less<>> entity_blocked;
+};
+
+const FeatureIndices& GetFeatureIndices() {
+  static const base::NoDestructor<FeatureIndices> indices;
+  return *indices;
+}
+
+}  // namespace
+
 BandwidthSavingsPredictor::BandwidthSavingsPredictor(
     const NamedThirdPartyRegistry* registry)
-    : tp_registry_(registry) {}
+    : tp_registry_(registry), features_(feature_count) {}
 
 BandwidthSavingsPredictor::~BandwidthSavingsPredictor() = default;
 
 void BandwidthSavingsPredictor::OnPageLoadTimingUpdated(
     const page_load_metrics::mojom::PageLoadTiming& timing) {
+  const FeatureIndices& indices = GetFeatureIndices();
+  auto set_feature = [this](size_t index, base::TimeDelta value) {
+    if (index < features_.size())
+      features_[index] = value.InMillisecondsF();
+  };
+
   // First meaningful paint
   if (timing.paint_timing->first_meaningful_paint.has_value())
-    feature_map_["metrics.firstMeaningfulPaint"] =
-        timing.paint_timing->first_meaningful_paint.value().InMillisecondsF();
+    set_feature(indices.first_meaningful_paint,
+                timing.paint_timing->first_meaningful_paint.value());
 
   // DOM Content Loaded
   if (timing.document_timing->dom_content_loaded_event_start.has_value())
-    feature_map_["metrics.observedDomContentLoaded"] =
-        timing.document_timing->dom_content_loaded_event_start.value()
-            .InMillisecondsF();
+    set_feature(indices.dom_content_loaded,
+                timing.document_timing->dom_content_loaded_event_start.value());
 
   // First contentful paint
   if (timing.paint_timing->first_contentful_paint.has_value())
-    feature_map_["metrics.observedFirstVisualChange"] =
-        timing.paint_timing->first_contentful_paint.value().InMillisecondsF();
+    set_feature(indices.first_visual_change,
+                timing.paint_timing->first_contentful_paint.value());
 
   // Load
   if (timing.document_timing->load_event_start.has_value())
-    feature_map_["metrics.observedLoad"] =
-        timing.document_timing->load_event_start.value().InMillisecondsF();
+    set_feature(indices.load,
+                timing.document_timing->load_event_start.value());
 }
 
 void BandwidthSavingsPredictor::OnSubresourceBlocked(
     const std::string& resource_url) {
-  feature_map_["adblockRequests"] += 1;
+  const FeatureIndices& indices = GetFeatureIndices();
+  if (indices.adblock_requests < features_.size())
+    features_[indices.adblock_requests] += 1;
 
   if (tp_registry_) {
     const auto tp_name = tp_registry_->GetThirdParty(resource_url);
-    if (tp_name.has_value())
-      feature_map_["thirdParties." + tp_name.value() + ".blocked"] = 1;
+    if (tp_name.has_value()) {
+      auto entity = indices.entity_blocked.find(tp_name.value());
+      if (entity != indices.entity_blocked.end())
+        features_[entity->second] = 1;
+    }
   }
 }
 
@@ -67,53 +196,31 @@ void BandwidthSavingsPredictor::OnResourceLoadComplete(
   }
   main_frame_url_ = main_frame_url;
 
+  const FeatureIndices& indices = GetFeatureIndices();
+  auto add_to_feature = [this](size_t index, double value) {
+    if (index < features_.size())
+      features_[index] += value;
+  };
+
   const bool is_third_party =
       !net::registry_controlled_domains::SameDomainOrHost(
           main_frame_url, resource_load_info.final_url,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
   if (is_third_party) {
-    feature_map_["resources.third-party.requestCount"] += 1;
-    feature_map_["resources.third-party.size"] +=
-        resource_load_info.raw_body_bytes;
+    add_to_feature(indices.third_party_request_count, 1);
+    add_to_feature(indices.third_party_size, resource_load_info.raw_body_bytes);
   }
 
-  feature_map_["resources.total.requestCount"] += 1;
-  feature_map_["resources.total.size"] += resource_load_info.raw_body_bytes;
-  feature_map_["transfer.total.size"] +=
-      resource_load_info.total_received_bytes;
-  std::string resource_type;
-  switch (resource_load_info.request_destination) {
-    case network::mojom::RequestDestination::kDocument:
-      resource_type = "document";
-      break;
-    case network::mojom::RequestDestination::kIframe:
-      resource_type = "document";
-      break;
-    case network::mojom::RequestDestination::kStyle:
-      resource_type = "stylesheet";
-      break;
-    case network::mojom::RequestDestination::kScript:
-      resource_type = "script";
-      break;
-    case network::mojom::RequestDestination::kImage:
-      resource_type = "image";
-      break;
-    case network::mojom::RequestDestination::kFont:
-      resource_type = "font";
-      break;
-    case network::mojom::RequestDestination::kAudio:
-    case network::mojom::RequestDestination::kTrack:
-    case network::mojom::RequestDestination::kVideo:
-      resource_type = "media";
-      break;
-    default:
-      resource_type = "other";
-      break;
-  }
-  feature_map_["resources." + resource_type + ".requestCount"] += 1;
-  feature_map_["resources." + resource_type + ".size"] +=
-      resource_load_info.raw_body_bytes;
+  add_to_feature(indices.total_request_count, 1);
+  add_to_feature(indices.total_size, resource_load_info.raw_body_bytes);
+  transfer_total_size_ += resource_load_info.total_received_bytes;
+
+  const ResourceType resource_type =
+      GetResourceType(resource_load_info.request_destination);
+  add_to_feature(indices.request_count[resource_type], 1);
+  add_to_feature(indices.size[resource_type],
+                 resource_load_info.raw_body_bytes);
 }
 
 double BandwidthSavingsPredictor::PredictSavingsBytes() const {
@@ -121,38 +228,45 @@ double BandwidthSavingsPredictor::PredictSavingsBytes() const {
       !main_frame_url_.SchemeIsHTTPOrHTTPS()) {
     return 0;
   }
-  const auto total_size = feature_map_.find("transfer.total.size");
-  if (total_size != feature_map_.end() && total_size->second > 0) {
-    VLOG(2) << main_frame_url_ << " total download size " << total_size->second
-            << " bytes";
+  if (transfer_total_size_ > 0) {
+    VLOG(2) << main_frame_url_ << " total download size "
+            << transfer_total_size_ << " bytes";
   } else {
     return 0;
   }
 
   // Short-circuit if nothing got blocked
-  const auto adblock_requests = feature_map_.find("adblockRequests");
-  if (adblock_requests == feature_map_.end() || adblock_requests->second < 1) {
+  const size_t adblock_requests = GetFeatureIndices().adblock_requests;
+  if (adblock_requests >= features_.size() ||
+      features_[adblock_requests] < 1) {
     return 0;
   }
   if (VLOG_IS_ON(3)) {
-    VLOG(3) << "Predicting on feature map:";
-    for (const auto& feature : feature_map_) {
-      VLOG(3) << feature.first << " :: " << feature.second;
+    VLOG(3) << "Predicting on feature vector:";
+    for (size_t i = 0; i < features_.size(); ++i) {
+      if (features_[i] != 0)
+        VLOG(3) << feature_sequence[i] << " :: " << features_[i];
     }
   }
-  double prediction = ::brave_perf_predictor::LinregPredictNamed(feature_map_);
+  double prediction = ::brave_perf_predictor::LinregPredictVector(features_);
   VLOG(2) << main_frame_url_ << " estimated saving " << prediction << " bytes";
   // Sanity check for predicted saving
   if (prediction > kSavingsAbsoluteOutlier &&
-      (prediction / kOutlierThreshold) > total_size->second) {
+      (prediction / kOutlierThreshold) > transfer_total_size_) {
     return 0;
   }
   return prediction;
 }
 
 void BandwidthSavingsPredictor::Reset() {
-  feature_map_.clear();
+  std::fill(features_.begin(), features_.end(), 0);
+  transfer_total_size_ = 0;
   main_frame_url_ = {};
 }
 
+double BandwidthSavingsPredictor::GetFeature(base::StringPiece name) const {
+  const size_t index = FeatureIndex(name);
+  return index < features_.size() ? features_[index] : 0;
+}
+
 }  // namespace brave_perf_predictor
@@ -7,9 +7,10 @@
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 
 #include <string>
+#include <vector>
 
-#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "url/gurl.h"
 
@@ -61,10 +62,20 @@ class BandwidthSavingsPredictor {
   FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseTiming);
   FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest,
                            FeaturiseResourceLoading);
+  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest,
+                           MatchesNamedFeaturePrediction);
+
+  // Returns the accumulated value of the model feature |name|.
+  double GetFeature(base::StringPiece name) const;
 
   GURL main_frame_url_;
   const NamedThirdPartyRegistry* tp_registry_;  // not owned
-  base::flat_map<std::string, double> feature_map_;
+  // Features are accumulated straight into the model's input vector, in
+  // |feature_sequence| order. Sized in the constructor, so that the model
+  // parameters stay out of this header.
+  std::vector<double> features_;
+  // Not a model feature, only used to sanity check predictions.
+  double transfer_total_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
@@ -11,6 +11,7 @@
 #include "base/run_loop.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "chrome/browser/predictors/loading_test_util.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "components/page_load_metrics/common/page_load_timing.h"
@@ -39,45 +40,45 @@ class BandwidthSavingsPredictorTest : public ::testing::Test {
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseBlocked) {
   predictor_->OnSubresourceBlocked("https://google-analytics.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 1);
-  EXPECT_EQ(predictor_->feature_map_["thirdParties.Google Analytics.blocked"],
+  EXPECT_EQ(predictor_->GetFeature("adblockRequests"), 1);
+  EXPECT_EQ(predictor_->GetFeature("thirdParties.Google Analytics.blocked"),
             1);
   predictor_->OnSubresourceBlocked("https://test.m.facebook.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 2);
+  EXPECT_EQ(predictor_->GetFeature("adblockRequests"), 2);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseTiming) {
   const auto empty_timing = page_load_metrics::CreatePageLoadTiming();
   predictor_->OnPageLoadTimingUpdated(*empty_timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 0);
+  EXPECT_EQ(predictor_->GetFeature("metrics.firstMeaningfulPaint"), 0);
+  EXPECT_EQ(predictor_->GetFeature("metrics.observedDomContentLoaded"), 0);
+  EXPECT_EQ(predictor_->GetFeature("metrics.observedFirstVisualChange"), 0);
+  EXPECT_EQ(predictor_->GetFeature("metrics.observedLoad"), 0);
 
   auto timing = page_load_metrics::CreatePageLoadTiming();
   timing->document_timing->dom_content_loaded_event_start =
       base::TimeDelta::FromMilliseconds(1000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 1000);
+  EXPECT_EQ(predictor_->GetFeature("metrics.observedDomContentLoaded"), 1000);
 
   timing->document_timing->load_event_start =
       base::TimeDelta::FromMilliseconds(2000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 2000);
+  EXPECT_EQ(predictor_->GetFeature("metrics.observedLoad"), 2000);
 
   timing->paint_timing->first_meaningful_paint =
       base::TimeDelta::FromMilliseconds(1500);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 1500);
+  EXPECT_EQ(predictor_->GetFeature("metrics.firstMeaningfulPaint"), 1500);
 
   timing->paint_timing->first_contentful_paint =
       base::TimeDelta::FromMilliseconds(800);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 800);
+  EXPECT_EQ(predictor_->GetFeature("metrics.observedFirstVisualChange"), 800);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
+  EXPECT_EQ(predictor_->GetFeature("resources.third-party.requestCount"), 0);
 
   const GURL main_frame("https://brave.com/");
 
@@ -86,9 +87,9 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
       network::mojom::RequestDestination::kStyle);
   fp_style->raw_body_bytes = 1000;
   predictor_->OnResourceLoadComplete(main_frame, *fp_style);
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
+  EXPECT_EQ(predictor_->GetFeature("resources.third-party.requestCount"), 0);
+  EXPECT_EQ(predictor_->GetFeature("resources.stylesheet.requestCount"), 1);
+  EXPECT_EQ(predictor_->GetFeature("resources.stylesheet.size"), 1000);
 
   auto tp_style = predictors::CreateResourceLoadInfo(
       "https://stackpath.bootstrapcdn.com/bootstrap/4.4.1/css/bootstrap.min.js",
@@ -96,14 +97,61 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
   tp_style->raw_body_bytes = 1001;
   predictor_->OnResourceLoadComplete(main_frame, *tp_style);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.size"], 1001);
+  EXPECT_EQ(predictor_->GetFeature("resources.third-party.requestCount"), 1);
+  EXPECT_EQ(predictor_->GetFeature("resources.stylesheet.requestCount"), 1);
+  EXPECT_EQ(predictor_->GetFeature("resources.script.requestCount"), 1);
+  EXPECT_EQ(predictor_->GetFeature("resources.stylesheet.size"), 1000);
+  EXPECT_EQ(predictor_->GetFeature("resources.script.size"), 1001);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.total.requestCount"], 2);
-  EXPECT_EQ(predictor_->feature_map_["resources.total.size"], 2001);
+  EXPECT_EQ(predictor_->GetFeature("resources.total.requestCount"), 2);
+  EXPECT_EQ(predictor_->GetFeature("resources.total.size"), 2001);
+}
+
+// The dense feature vector must predict exactly what the named features of
+// the same page did.
+TEST_F(BandwidthSavingsPredictorTest, MatchesNamedFeaturePrediction) {
+  const GURL main_frame("https://brave.com");
+  base::flat_map<std::string, double> named_features;
+
+  auto timing = page_load_metrics::CreatePageLoadTiming();
+  timing->document_timing->dom_content_loaded_event_start =
+      base::TimeDelta::FromMilliseconds(900);
+  timing->document_timing->load_event_start =
+      base::TimeDelta::FromMilliseconds(1800);
+  timing->paint_timing->first_contentful_paint =
+      base::TimeDelta::FromMilliseconds(700);
+  predictor_->OnPageLoadTimingUpdated(*timing);
+  named_features["metrics.observedDomContentLoaded"] = 900;
+  named_features["metrics.observedLoad"] = 1800;
+  named_features["metrics.observedFirstVisualChange"] = 700;
+
+  auto document = predictors::CreateResourceLoadInfo(
+      "https://brave.com/", network::mojom::RequestDestination::kDocument);
+  document->raw_body_bytes = 30000;
+  predictor_->OnResourceLoadComplete(main_frame, *document);
+  auto image = predictors::CreateResourceLoadInfo(
+      "https://cdn.example.com/a.png",
+      network::mojom::RequestDestination::kImage);
+  image->raw_body_bytes = 50000;
+  predictor_->OnResourceLoadComplete(main_frame, *image);
+  named_features["resources.document.requestCount"] = 1;
+  named_features["resources.document.size"] = 30000;
+  named_features["resources.image.requestCount"] = 1;
+  named_features["resources.image.size"] = 50000;
+  named_features["resources.third-party.requestCount"] = 1;
+  named_features["resources.third-party.size"] = 50000;
+  named_features["resources.total.requestCount"] = 2;
+  named_features["resources.total.size"] = 80000;
+
+  predictor_->OnSubresourceBlocked("https://google-analytics.com/ga.js");
+  predictor_->OnSubresourceBlocked("https://connect.facebook.net/sdk.js");
+  predictor_->OnSubresourceBlocked("https://unknown.example.org/x.js");
+  named_features["adblockRequests"] = 3;
+  named_features["thirdParties.Google Analytics.blocked"] = 1;
+  named_features["thirdParties.Facebook.blocked"] = 1;
+
+  EXPECT_DOUBLE_EQ(LinregPredictNamed(named_features),
+                   LinregPredictVector(predictor_->features_));
 }
 
 TEST_F(BandwidthSavingsPredictorTest, PredictZeroNoData) {
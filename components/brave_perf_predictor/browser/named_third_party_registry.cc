@@ -5,7 +5,8 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
-#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/containers/flat_set.h"
@@ -27,11 +28,10 @@ namespace brave_perf_predictor {
 
 namespace {
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
-  base::flat_map<std::string, std::string> entity_by_domain;
-  base::flat_map<std::string, std::string> entity_by_root_domain;
+NamedThirdPartyRegistry::EntityMappings ParseMappings(
+    const base::StringPiece entities,
+    bool discard_irrelevant) {
+  NamedThirdPartyRegistry::EntityMappings mappings;
 
   // Parse the JSON
   base::Optional<base::Value> document = base::JSONReader::Read(entities);
@@ -40,7 +40,11 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     return {};
   }
 
-  // Collect the mappings
+  // Collect the mappings. Entries are gathered into vectors first and sorted
+  // once by flat_map's range constructor, instead of being inserted one by
+  // one.
+  std::vector<std::pair<std::string, size_t>> entity_by_domain;
+  base::flat_map<std::string, size_t> entity_by_root_domain;
   for (auto& entity : document->GetList()) {
     const std::string* entity_name = entity.FindStringPath("name");
     if (!entity_name)
@@ -53,40 +57,41 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     if (!entity_domains)
       continue;
 
+    const size_t entity_index = mappings.entities.size();
+    mappings.entities.push_back(*entity_name);
     for (auto& entity_domain_it : entity_domains->GetList()) {
       if (!entity_domain_it.is_string()) {
         continue;
       }
       const base::StringPiece entity_domain(entity_domain_it.GetString());
 
-      const auto inserted =
-          entity_by_domain.emplace(entity_domain, *entity_name);
-      if (!inserted.second) {
-        VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
-      }
+      entity_by_domain.emplace_back(entity_domain.as_string(), entity_index);
       auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
           entity_domain,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
       auto root_entity_entry = entity_by_root_domain.find(root_domain);
       if (root_entity_entry != entity_by_root_domain.end() &&
-          root_entity_entry->second != *entity_name) {
+          mappings.entities[root_entity_entry->second] != *entity_name) {
         // If there is a clash at root domain level, neither is correct
         entity_by_root_domain.erase(root_entity_entry);
       } else {
-        entity_by_root_domain.emplace(root_domain, *entity_name);
+        entity_by_root_domain.emplace(root_domain, entity_index);
       }
     }
   }
 
-  entity_by_domain.shrink_to_fit();
-  entity_by_root_domain.shrink_to_fit();
-  return std::make_tuple(entity_by_domain, entity_by_root_domain);
+  // The first occurrence of a duplicate domain wins, as flat_map keeps the
+  // first of equal keys.
+  mappings.entity_by_domain =
+      NamedThirdPartyRegistry::EntityIndexMap(std::move(entity_by_domain));
+  mappings.entity_by_root_domain = NamedThirdPartyRegistry::EntityIndexMap(
+      std::move(entity_by_root_domain).extract());
+  mappings.entities.shrink_to_fit();
+  return mappings;
 }
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseFromResource(int resource_id) {
+NamedThirdPartyRegistry::EntityMappings ParseFromResource(int resource_id) {
   // TODO(AndriusA): insert trace event here
   SCOPED_UMA_HISTOGRAM_TIMER(
       "Brave.Savings.NamedThirdPartyRegistry.LoadTimeMS");
@@ -99,28 +104,34 @@ ParseFromResource(int resource_id) {
 
 }  // namespace
 
+NamedThirdPartyRegistry::EntityMappings::EntityMappings() = default;
+NamedThirdPartyRegistry::EntityMappings::EntityMappings(
+    EntityMappings&& other) = default;
+NamedThirdPartyRegistry::EntityMappings&
+NamedThirdPartyRegistry::EntityMappings::operator=(EntityMappings&& other) =
+    default;
+NamedThirdPartyRegistry::EntityMappings::~EntityMappings() = default;
+
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
   // Reset previous mappings
-  entity_by_domain_.clear();
-  entity_by_root_domain_.clear();
+  mappings_ = EntityMappings();
   initialized_ = false;
 
-  tie(entity_by_domain_, entity_by_root_domain_) =
-      ParseMappings(entities, discard_irrelevant);
-  if (entity_by_domain_.size() == 0 || entity_by_root_domain_.size() == 0)
+  mappings_ = ParseMappings(entities, discard_irrelevant);
+  if (mappings_.entity_by_domain.empty() ||
+      mappings_.entity_by_root_domain.empty())
     return false;
 
   initialized_ = true;
   return true;
 }
 
-void NamedThirdPartyRegistry::UpdateMappings(
-    std::tuple<base::flat_map<std::string, std::string>,
-               base::flat_map<std::string, std::string>> entity_mappings) {
-  tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
+void NamedThirdPartyRegistry::UpdateMappings(EntityMappings entity_mappings) {
+  mappings_ = std::move(entity_mappings);
+  VLOG(2) << "Loaded " << mappings_.entity_by_domain.size()
+          << " mappings by domain and "
+          << mappings_.entity_by_root_domain.size() << " by root domain; size";
   initialized_ = true;
 }
 
@@ -136,16 +147,16 @@ base::Optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
     return base::nullopt;
 
   if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
+    auto domain_entry = mappings_.entity_by_domain.find(url.host_piece());
+    if (domain_entry != mappings_.entity_by_domain.end())
+      return mappings_.entities[domain_entry->second];
 
     auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
         url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
+    auto root_domain_entry = mappings_.entity_by_root_domain.find(root_domain);
+    if (root_domain_entry != mappings_.entity_by_root_domain.end())
+      return mappings_.entities[root_domain_entry->second];
   }
 
   return base::nullopt;
@@ -6,8 +6,9 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
+#include <functional>
 #include <string>
-#include <tuple>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
@@ -36,16 +37,28 @@ class NamedThirdPartyRegistry : public KeyedService {
   base::Optional<std::string> GetThirdParty(
       const base::StringPiece domain) const;
 
+  // Entity names are stored once and referenced by index from the domain
+  // maps. The maps use a transparent comparator so that they can be queried
+  // with the host of a URL without copying it.
+  using EntityIndexMap = base::flat_map<std::string, size_t, std::less<>>;
+  struct EntityMappings {
+    EntityMappings();
+    EntityMappings(EntityMappings&& other);
+    EntityMappings& operator=(EntityMappings&& other);
+    ~EntityMappings();
+
+    std::vector<std::string> entities;
+    EntityIndexMap entity_by_domain;
+    EntityIndexMap entity_by_root_domain;
+  };
+
  private:
   bool IsInitialized() const { return initialized_; }
   void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
+  void UpdateMappings(EntityMappings entity_mappings);
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
+  EntityMappings mappings_;
 
   base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
 };
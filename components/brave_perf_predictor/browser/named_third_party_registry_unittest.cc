@@ -119,4 +119,26 @@ TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   EXPECT_FALSE(entity.has_value());
 }
 
+TEST(NamedThirdPartyRegistryTest, HandlesRootDomainClashTest) {
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  bool parsed = extractor->LoadMappings(R"([
+      {"name":"First", "domains":["a.shared.com","first.com"]},
+      {"name":"Second", "domains":["b.shared.com","second.com"]}
+  ])", false);
+  ASSERT_TRUE(parsed);
+
+  auto entity = extractor->GetThirdParty("https://a.shared.com/x.js");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "First");
+  entity = extractor->GetThirdParty("https://b.shared.com/x.js");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "Second");
+  entity = extractor->GetThirdParty("https://cdn.first.com/x.js");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "First");
+
+  // Root domains claimed by different entities don't resolve to either.
+  EXPECT_FALSE(extractor->GetThirdParty("https://c.shared.com/").has_value());
+}
+
 }  // namespace brave_perf_predictor
@@ -44,21 +44,28 @@ P3ABandwidthSavingsTracker::P3ABandwidthSavingsTracker(PrefService* user_prefs)
 
 P3ABandwidthSavingsTracker::P3ABandwidthSavingsTracker(
     PrefService* user_prefs,
-    std::unique_ptr<base::Clock> clock)
-    : user_prefs_(user_prefs), clock_(std::move(clock)) {}
+    std::unique_ptr<base::Clock> clock) {
+  if (user_prefs) {
+    storage_ = std::make_unique<WeeklyStorage>(
+        user_prefs, prefs::kBandwidthSavedDailyBytes, std::move(clock));
+  }
+}
 
 void P3ABandwidthSavingsTracker::RecordSavings(uint64_t savings) {
-  if (savings > 0 && user_prefs_) {
-    // TODO(AndriusA): optimise if needed, loading permanent state on every
-    // record could be costly
-    WeeklyStorage weekly(user_prefs_, prefs::kBandwidthSavedDailyBytes);
-    weekly.AddDelta(savings);
-    StoreSavingsHistogram(weekly.GetWeeklySum());
+  if (savings > 0 && storage_) {
+    storage_->AddDelta(savings);
+    StoreSavingsHistogram(storage_->GetWeeklySum());
   }
 }
 
 P3ABandwidthSavingsTracker::~P3ABandwidthSavingsTracker() = default;
 
+void P3ABandwidthSavingsTracker::Shutdown() {
+  // Prefs go away with the profile, so pending changes can't wait for the
+  // destructor.
+  storage_.reset();
+}
+
 // static
 void P3ABandwidthSavingsTracker::RegisterPrefs(PrefRegistrySimple* registry) {
   if (registry)
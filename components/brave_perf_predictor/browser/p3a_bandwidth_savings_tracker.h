@@ -9,8 +9,11 @@
 #include <cstdint>
 #include <memory>
 
+#include "components/keyed_service/core/keyed_service.h"
+
 class PrefRegistrySimple;
 class PrefService;
+class WeeklyStorage;
 
 namespace base {
 class Clock;
@@ -18,13 +21,16 @@ class Clock;
 
 namespace brave_perf_predictor {
 
-class P3ABandwidthSavingsTracker {
+// Keeps the weekly bandwidth savings of a profile and reports them to P3A.
+// There is one per profile (see P3ABandwidthSavingsTrackerFactory), so the
+// savings are loaded from prefs once and written back in batches.
+class P3ABandwidthSavingsTracker : public KeyedService {
  public:
   explicit P3ABandwidthSavingsTracker(PrefService* user_prefs);
   // Constructor with injected clock for testing
   P3ABandwidthSavingsTracker(PrefService* user_prefs,
                              std::unique_ptr<base::Clock> clock);
-  ~P3ABandwidthSavingsTracker();
+  ~P3ABandwidthSavingsTracker() override;
   P3ABandwidthSavingsTracker(const P3ABandwidthSavingsTracker&) = delete;
   P3ABandwidthSavingsTracker& operator=(const P3ABandwidthSavingsTracker&) =
       delete;
@@ -32,10 +38,13 @@ class P3ABandwidthSavingsTracker {
   static void RegisterPrefs(PrefRegistrySimple* registry);
   void RecordSavings(uint64_t savings);
 
+  // KeyedService:
+  void Shutdown() override;
+
  private:
-  PrefService* user_prefs_;
-  std::unique_ptr<base::Clock> clock_;  // Injected clock for testing
   void StoreSavingsHistogram(uint64_t savings_bytes);
+
+  std::unique_ptr<WeeklyStorage> storage_;
 };
 
 }  // namespace brave_perf_predictor
@@ -0,0 +1,43 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_P3A_BANDWIDTH_SAVINGS_TRACKER_FACTORY_H_
+#define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_P3A_BANDWIDTH_SAVINGS_TRACKER_FACTORY_H_
+
+#include "base/memory/singleton.h"
+#include "components/keyed_service/content/browser_context_keyed_service_factory.h"
+#include "components/keyed_service/core/keyed_service.h"
+
+namespace brave_perf_predictor {
+
+class P3ABandwidthSavingsTracker;
+
+class P3ABandwidthSavingsTrackerFactory
+    : public BrowserContextKeyedServiceFactory {
+ public:
+  static P3ABandwidthSavingsTrackerFactory* GetInstance();
+  // Returns null for off the record profiles.
+  static P3ABandwidthSavingsTracker* GetForBrowserContext(
+      content::BrowserContext* context);
+
+ private:
+  friend struct base::DefaultSingletonTraits<
+      P3ABandwidthSavingsTrackerFactory>;
+  P3ABandwidthSavingsTrackerFactory();
+  ~P3ABandwidthSavingsTrackerFactory() override;
+
+  P3ABandwidthSavingsTrackerFactory(const P3ABandwidthSavingsTrackerFactory&) =
+      delete;
+  P3ABandwidthSavingsTrackerFactory& operator=(
+      const P3ABandwidthSavingsTrackerFactory&) = delete;
+
+  // BrowserContextKeyedServiceFactory overrides:
+  KeyedService* BuildServiceInstanceFor(
+      content::BrowserContext* context) const override;
+};
+
+}  // namespace brave_perf_predictor
+
+#endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_P3A_BANDWIDTH_SAVINGS_TRACKER_FACTORY_H_
@@ -10,7 +10,10 @@
 
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "base/values.h"
+#include "brave/components/brave_perf_predictor/common/pref_names.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -29,6 +32,7 @@ class P3ABandwidthSavingsTrackerTest : public ::testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_;
   base::SimpleTestClock* clock_;
   TestingPrefServiceSimple pref_service_;
   std::unique_ptr<P3ABandwidthSavingsTracker> tracker_;
@@ -56,4 +60,17 @@ TEST_F(P3ABandwidthSavingsTrackerTest, RecordSavingsHistogramLargeIncrements) {
   tester.ExpectBucketCount(kSavingsDailyUMAHistogramName, 6, 1);
 }
 
+TEST_F(P3ABandwidthSavingsTrackerTest, WritesPrefsInBatches) {
+  const base::ListValue* daily_savings =
+      pref_service_.GetList(prefs::kBandwidthSavedDailyBytes);
+  tracker_->RecordSavings(10 << 20);
+  tracker_->RecordSavings(20 << 20);
+  EXPECT_TRUE(daily_savings->GetList().empty());
+
+  // Pending savings are written when the profile shuts down.
+  tracker_->Shutdown();
+  daily_savings = pref_service_.GetList(prefs::kBandwidthSavedDailyBytes);
+  EXPECT_EQ(1UL, daily_savings->GetList().size());
+}
+
 }  // namespace brave_perf_predictor
@@ -6,6 +6,7 @@
 #include "brave/components/brave_perf_predictor/browser/perf_predictor_tab_helper.h"
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry_factory.h"
+#include "brave/components/brave_perf_predictor/browser/p3a_bandwidth_savings_tracker_factory.h"
 #include "brave/components/brave_perf_predictor/common/pref_names.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
@@ -43,11 +44,9 @@ PerfPredictorTabHelper::PerfPredictorTabHelper(
       bandwidth_predictor_(std::make_unique<BandwidthSavingsPredictor>(
           NamedThirdPartyRegistryFactory::GetForBrowserContext(
               web_contents->GetBrowserContext()))) {
-  if (web_contents->GetBrowserContext()->IsOffTheRecord())
-    return;
-
-  bandwidth_tracker_ = std::make_unique<P3ABandwidthSavingsTracker>(
-      user_prefs::UserPrefs::Get(web_contents->GetBrowserContext()));
+  // Off the record profiles get no tracker.
+  bandwidth_tracker_ = P3ABandwidthSavingsTrackerFactory::GetForBrowserContext(
+      web_contents->GetBrowserContext());
 }
 
 PerfPredictorTabHelper::~PerfPredictorTabHelper() = default;
@@ -95,7 +95,8 @@ class PerfPredictorTabHelper
 
   int64_t navigation_id_ = -1;
   std::unique_ptr<BandwidthSavingsPredictor> bandwidth_predictor_;
-  std::unique_ptr<P3ABandwidthSavingsTracker> bandwidth_tracker_;
+  // Owned by the profile.
+  P3ABandwidthSavingsTracker* bandwidth_tracker_ = nullptr;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 };
@@ -0,0 +1,102 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "base/values.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+constexpr size_t kNoMatch = static_cast<size_t>(-1);
+
+// URLPattern ignores a trailing dot on both the pattern and the tested host.
+base::StringPiece StripTrailingDot(base::StringPiece host) {
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+  return host;
+}
+
+}  // namespace
+
+ReferralHeadersMatcher::ReferralHeadersMatcher(
+    const base::ListValue& referral_headers_list)
+    : match_all_index_(kNoMatch) {
+  std::vector<std::pair<std::string, size_t>> domains;
+  for (const auto& headers_value : referral_headers_list) {
+    const base::Value* domains_list =
+        headers_value.FindKeyOfType("domains", base::Value::Type::LIST);
+    if (!domains_list) {
+      LOG(WARNING) << "Failed to retrieve 'domains' key from referral headers";
+      continue;
+    }
+    const base::Value* headers_dict =
+        headers_value.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
+    if (!headers_dict) {
+      LOG(WARNING) << "Failed to retrieve 'headers' key from referral headers";
+      continue;
+    }
+
+    const size_t index = headers_.size();
+    Headers headers;
+    for (const auto& it : headers_dict->DictItems()) {
+      if (it.second.is_string())
+        headers.emplace_back(it.first, it.second.GetString());
+    }
+    headers_.push_back(std::move(headers));
+
+    for (const auto& domain_value : domains_list->GetList()) {
+      if (!domain_value.is_string())
+        continue;
+      const base::StringPiece domain =
+          StripTrailingDot(domain_value.GetString());
+      if (domain.empty()) {
+        match_all_index_ = std::min(match_all_index_, index);
+        continue;
+      }
+      domains.emplace_back(domain.as_string(), index);
+    }
+  }
+  // flat_map keeps the first of duplicate keys, i.e. the earliest entry.
+  domains_ = base::flat_map<std::string, size_t, std::less<>>(
+      std::move(domains));
+}
+
+ReferralHeadersMatcher::~ReferralHeadersMatcher() = default;
+
+const ReferralHeadersMatcher::Headers*
+ReferralHeadersMatcher::GetMatchingHeaders(const GURL& url) const {
+  if (!url.SchemeIsHTTPOrHTTPS())
+    return nullptr;
+
+  // Several listed domains may match (e.g. both "a.com" and "b.a.com"), in
+  // which case the entry that comes first in the list wins.
+  size_t index = match_all_index_;
+  base::StringPiece host = StripTrailingDot(url.host_piece());
+  const bool match_subdomains = !url.HostIsIPAddress();
+  while (!host.empty()) {
+    auto it = domains_.find(host);
+    if (it != domains_.end())
+      index = std::min(index, it->second);
+    if (!match_subdomains)
+      break;
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+
+  if (index == kNoMatch)
+    return nullptr;
+  return &headers_[index];
+}
+
+}  // namespace brave
@@ -0,0 +1,53 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+
+class GURL;
+
+namespace base {
+class ListValue;
+}
+
+namespace brave {
+
+// Immutable lookup table built once from the referral headers list
+// (kReferralHeaders). Matches the same URLs as
+// BraveReferralsService::GetMatchingReferralHeaders, i.e. http(s) URLs whose
+// host is one of the listed domains or a subdomain of it, without building a
+// URLPattern per domain on every request.
+class ReferralHeadersMatcher {
+ public:
+  using Headers = std::vector<std::pair<std::string, std::string>>;
+
+  explicit ReferralHeadersMatcher(const base::ListValue& referral_headers_list);
+  ~ReferralHeadersMatcher();
+
+  // Returns the headers of the first list entry matching |url|, or nullptr.
+  const Headers* GetMatchingHeaders(const GURL& url) const;
+
+ private:
+  // Headers of each valid list entry, in list order.
+  std::vector<Headers> headers_;
+  // Domain -> index into |headers_| of the first entry listing it.
+  base::flat_map<std::string, size_t, std::less<>> domains_;
+  // Index of the first entry with an empty domain, which matches every host.
+  size_t match_all_index_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReferralHeadersMatcher);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
@@ -0,0 +1,115 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
+
+#include <string>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "brave/components/brave_referrals/browser/brave_referrals_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+const char kTestReferralHeaders[] = R"(
+  [
+    {
+      "domains": [ "marketwatch.com", "barrons.com" ],
+      "headers": { "X-Brave-Partner": "dowjones", "X-Invalid": "test" }
+    },
+    {
+      "headers": { "X-Brave-Partner": "missing-domains" }
+    },
+    {
+      "domains": [ "news.marketwatch.com", "xxlmag.com." ],
+      "headers": { "X-Brave-Partner": "townsquare" }
+    },
+    {
+      "domains": [ "xxlmag.com" ],
+      "headers": { "X-Brave-Partner": "duplicate" }
+    }
+  ])";
+
+std::string GetPartner(const brave::ReferralHeadersMatcher::Headers* headers) {
+  if (!headers)
+    return std::string();
+  for (const auto& header : *headers) {
+    if (header.first == "X-Brave-Partner")
+      return header.second;
+  }
+  return std::string();
+}
+
+std::string GetPartner(const base::DictionaryValue* headers) {
+  if (!headers)
+    return std::string();
+  const std::string* partner = headers->FindStringKey("X-Brave-Partner");
+  return partner ? *partner : std::string();
+}
+
+}  // namespace
+
+TEST(ReferralHeadersMatcherTest, MatchesLikeURLPattern) {
+  base::Optional<base::Value> referral_headers =
+      base::JSONReader::Read(kTestReferralHeaders);
+  ASSERT_TRUE(referral_headers);
+  const base::ListValue* referral_headers_list = nullptr;
+  ASSERT_TRUE(referral_headers->GetAsList(&referral_headers_list));
+
+  const brave::ReferralHeadersMatcher matcher(*referral_headers_list);
+
+  const char* const kUrls[] = {
+      "https://marketwatch.com/",
+      "https://www.marketwatch.com/path?query",
+      "http://news.marketwatch.com/",
+      "https://marketwatch.com./",
+      "https://xxlmag.com/",
+      "https://a.b.xxlmag.com:8080/",
+      "https://notmarketwatch.com/",
+      "https://marketwatch.com.evil.com/",
+      "https://google.com/",
+      "ftp://marketwatch.com/",
+      "wss://marketwatch.com/",
+      "https://127.0.0.1/",
+      "about:blank",
+      "",
+  };
+  for (const char* url : kUrls) {
+    SCOPED_TRACE(url);
+    const GURL gurl(url);
+    const base::DictionaryValue* expected = nullptr;
+    if (!brave::BraveReferralsService::GetMatchingReferralHeaders(
+            *referral_headers_list, &expected, gurl)) {
+      expected = nullptr;
+    }
+    const brave::ReferralHeadersMatcher::Headers* actual =
+        matcher.GetMatchingHeaders(gurl);
+    EXPECT_EQ(!!expected, !!actual);
+    EXPECT_EQ(GetPartner(expected), GetPartner(actual));
+  }
+}
+
+TEST(ReferralHeadersMatcherTest, FirstListedEntryWins) {
+  base::Optional<base::Value> referral_headers =
+      base::JSONReader::Read(kTestReferralHeaders);
+  ASSERT_TRUE(referral_headers);
+  const base::ListValue* referral_headers_list = nullptr;
+  ASSERT_TRUE(referral_headers->GetAsList(&referral_headers_list));
+
+  const brave::ReferralHeadersMatcher matcher(*referral_headers_list);
+
+  // "marketwatch.com" is listed before "news.marketwatch.com".
+  EXPECT_EQ("dowjones", GetPartner(matcher.GetMatchingHeaders(
+                            GURL("https://news.marketwatch.com/"))));
+  EXPECT_EQ("townsquare",
+            GetPartner(matcher.GetMatchingHeaders(GURL("https://xxlmag.com"))));
+
+  const brave::ReferralHeadersMatcher::Headers* headers =
+      matcher.GetMatchingHeaders(GURL("https://barrons.com/"));
+  ASSERT_TRUE(headers);
+  EXPECT_EQ(2u, headers->size());
+}
@@ -76,16 +76,17 @@ int OnBeforeURLRequest(
   std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  if (IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer)) {
-    if (!ctx->upload_data.empty()) {
-      DispatchOnUI(ctx->upload_data,
-                   ctx->request_url,
-                   ctx->tab_url,
-                   ctx->referrer.spec(),
-                   ctx->render_process_id,
-                   ctx->render_frame_id,
-                   ctx->frame_tree_node_id);
-    }
+  // Only POSTed media pings are reported, so check for a body before
+  // classifying the url
+  if (!ctx->upload_data.empty() &&
+      IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer)) {
+    DispatchOnUI(ctx->upload_data,
+                 ctx->request_url,
+                 ctx->tab_url,
+                 ctx->referrer.spec(),
+                 ctx->render_process_id,
+                 ctx->render_frame_id,
+                 ctx->frame_tree_node_id);
   }
 
   return net::OK;
@@ -33,6 +33,7 @@
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "crypto/sha2.h"
 #include "extensions/buildflags/buildflags.h"
 #include "ipc/ipc_message_macros.h"
 
@@ -52,6 +53,33 @@ using content::WebContents;
 
 namespace {
 
+base::TimeDelta g_stats_flush_interval = base::TimeDelta::FromSeconds(1);
+
+// Upper bound on the blocked URLs remembered per page. Past it, repeated
+// loads of URLs not seen yet are counted again.
+constexpr size_t kMaxBlockedSubresources = 10000;
+
+#if !defined(OS_ANDROID)
+// Blocked resources are reported to the extension at most this often.
+constexpr base::TimeDelta kBlockedEventsDispatchDelay =
+    base::TimeDelta::FromMilliseconds(100);
+#endif
+
+// The first 64 bits of the URL's SHA-256. A 32-bit hash collides too easily
+// across thousands of URLs, which would make an unseen URL look already
+// blocked; at 64 bits a collision within one page is very unlikely, though
+// not impossible.
+uint64_t GetSubresourceKey(const std::string& subresource) {
+  uint64_t key = 0;
+  crypto::SHA256HashString(subresource, &key, sizeof(key));
+  return key;
+}
+
+void AddToStat(PrefService* prefs, const char* pref_name, uint64_t count) {
+  if (count)
+    prefs->SetUint64(pref_name, prefs->GetUint64(pref_name) + count);
+}
+
 // Content Settings are only sent to the main frame currently.
 // Chrome may fix this at some point, but for now we do this as a work-around.
 // You can verify if this is fixed by running the following test:
@@ -97,6 +125,34 @@ WebContents* GetWebContents(
   return web_contents;
 }
 
+#if !defined(OS_ANDROID) && BUILDFLAG(ENABLE_EXTENSIONS)
+void BroadcastBlockedEvents(
+    WebContents* web_contents,
+    const std::vector<std::pair<std::string, std::string>>& blocked_events) {
+  Profile* profile =
+      Profile::FromBrowserContext(web_contents->GetBrowserContext());
+  EventRouter* event_router = EventRouter::Get(profile);
+  if (!profile || !event_router) {
+    return;
+  }
+  const int tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
+  std::vector<extensions::api::brave_shields::BlockedResource> details(
+      blocked_events.size());
+  for (size_t i = 0; i < blocked_events.size(); ++i) {
+    details[i].tab_id = tab_id;
+    details[i].block_type = blocked_events[i].first;
+    details[i].subresource = blocked_events[i].second;
+  }
+  std::unique_ptr<base::ListValue> args(
+      extensions::api::brave_shields::OnBlocked::Create(details).release());
+  std::unique_ptr<Event> event(
+      new Event(extensions::events::BRAVE_AD_BLOCKED,
+        extensions::api::brave_shields::OnBlocked::kEventName,
+        std::move(args)));
+  event_router->BroadcastEvent(std::move(event));
+}
+#endif
+
 }  // namespace
 
 namespace brave_shields {
@@ -132,6 +188,12 @@ bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator==(
 BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
 }
 
+// static
+void BraveShieldsWebContentsObserver::SetStatsFlushIntervalForTesting(
+    base::TimeDelta interval) {
+  g_stats_flush_interval = interval;
+}
+
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
     WebContents* web_contents)
     : WebContentsObserver(web_contents) {
@@ -211,12 +273,92 @@ GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
 
 bool BraveShieldsWebContentsObserver::IsBlockedSubresource(
     const std::string& subresource) {
-  return blocked_url_paths_.find(subresource) != blocked_url_paths_.end();
+  return blocked_subresource_hashes_.count(GetSubresourceKey(subresource)) != 0;
 }
 
 void BraveShieldsWebContentsObserver::AddBlockedSubresource(
     const std::string& subresource) {
-  blocked_url_paths_.insert(subresource);
+  if (blocked_subresource_hashes_.size() < kMaxBlockedSubresources)
+    blocked_subresource_hashes_.insert(GetSubresourceKey(subresource));
+}
+
+void BraveShieldsWebContentsObserver::IncrementBlockedCount(
+    const std::string& block_type) {
+  if (block_type == kAds) {
+    ++pending_ads_blocked_;
+  } else if (block_type == kHTTPUpgradableResources) {
+    ++pending_https_upgrades_;
+  } else if (block_type == kJavaScript) {
+    ++pending_javascript_blocked_;
+  } else if (block_type == kFingerprintingV2) {
+    ++pending_fingerprinting_blocked_;
+  } else {
+    return;
+  }
+
+  if (g_stats_flush_interval.is_zero()) {
+    FlushBlockedCounts();
+    return;
+  }
+
+  if (!stats_flush_timer_.IsRunning()) {
+    stats_flush_timer_.Start(FROM_HERE, g_stats_flush_interval, this,
+        &BraveShieldsWebContentsObserver::FlushBlockedCounts);
+  }
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedCounts() {
+  stats_flush_timer_.Stop();
+
+  PrefService* prefs = Profile::FromBrowserContext(
+      web_contents()->GetBrowserContext())->
+      GetOriginalProfile()->
+      GetPrefs();
+  AddToStat(prefs, kAdsBlocked, pending_ads_blocked_);
+  AddToStat(prefs, kHttpsUpgrades, pending_https_upgrades_);
+  AddToStat(prefs, kJavascriptBlocked, pending_javascript_blocked_);
+  AddToStat(prefs, kFingerprintingBlocked, pending_fingerprinting_blocked_);
+
+  pending_ads_blocked_ = 0;
+  pending_https_upgrades_ = 0;
+  pending_javascript_blocked_ = 0;
+  pending_fingerprinting_blocked_ = 0;
+}
+
+#if !defined(OS_ANDROID)
+void BraveShieldsWebContentsObserver::QueueBlockedEvent(
+    const std::string& block_type,
+    const std::string& subresource) {
+  // The extension keeps a set of blocked resources per tab, so repeats within
+  // a batch carry no information.
+  if (!pending_blocked_event_set_.emplace(block_type, subresource).second)
+    return;
+  pending_blocked_events_.emplace_back(block_type, subresource);
+
+  if (!blocked_events_timer_.IsRunning()) {
+    blocked_events_timer_.Start(FROM_HERE, kBlockedEventsDispatchDelay, this,
+        &BraveShieldsWebContentsObserver::DispatchPendingBlockedEvents);
+  }
+}
+
+void BraveShieldsWebContentsObserver::DispatchPendingBlockedEvents() {
+  blocked_events_timer_.Stop();
+  if (pending_blocked_events_.empty()) {
+    return;
+  }
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  BroadcastBlockedEvents(web_contents(), pending_blocked_events_);
+#endif
+  pending_blocked_events_.clear();
+  pending_blocked_event_set_.clear();
+}
+#endif
+
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+#if !defined(OS_ANDROID)
+  DispatchPendingBlockedEvents();
+#endif
+  FlushBlockedCounts();
 }
 
 // static
@@ -238,22 +380,7 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
     if (observer &&
         !observer->IsBlockedSubresource(subresource)) {
       observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprintingV2) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
+      observer->IncrementBlockedCount(block_type);
     }
   }
 }
@@ -267,23 +394,13 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
   if (!web_contents) {
     return;
   }
-  Profile* profile =
-      Profile::FromBrowserContext(web_contents->GetBrowserContext());
-  EventRouter* event_router = EventRouter::Get(profile);
-  if (profile && event_router) {
-    extensions::api::brave_shields::OnBlocked::Details details;
-    details.tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
-    details.block_type = block_type;
-    details.subresource = subresource;
-    std::unique_ptr<base::ListValue> args(
-        extensions::api::brave_shields::OnBlocked::Create(details)
-          .release());
-    std::unique_ptr<Event> event(
-        new Event(extensions::events::BRAVE_AD_BLOCKED,
-          extensions::api::brave_shields::OnBlocked::kEventName,
-          std::move(args)));
-    event_router->BroadcastEvent(std::move(event));
+  BraveShieldsWebContentsObserver* observer =
+      BraveShieldsWebContentsObserver::FromWebContents(web_contents);
+  if (observer) {
+    observer->QueueBlockedEvent(block_type, subresource);
+    return;
   }
+  BroadcastBlockedEvents(web_contents, {{block_type, subresource}});
 #endif
 }
 #endif
@@ -343,8 +460,16 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
       !navigation_handle->IsSameDocument() &&
       navigation_handle->GetReloadType() == content::ReloadType::NONE) {
     allowed_script_origins_.clear();
-    blocked_url_paths_.clear();
+    blocked_subresource_hashes_.clear();
   }
+#if !defined(OS_ANDROID)
+  // Report the previous page's blocked resources before the extension sees
+  // the navigation and resets the tab's data.
+  if (navigation_handle->IsInMainFrame() &&
+      !navigation_handle->IsSameDocument()) {
+    DispatchPendingBlockedEvents();
+  }
+#endif
 
   navigation_handle->GetWebContents()->SendToAllFrames(
       new BraveFrameMsg_AllowScriptsOnce(
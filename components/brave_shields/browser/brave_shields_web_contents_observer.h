@@ -7,13 +7,18 @@
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 
 #include <map>
-#include <set>
 #include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "base/containers/flat_set.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "build/build_config.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -49,6 +54,10 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
 
+  // Blocked resource counts are committed to the stats prefs at most once
+  // per |interval|. A zero interval writes every count through immediately.
+  static void SetStatsFlushIntervalForTesting(base::TimeDelta interval);
+
  protected:
     // A set of identifiers that uniquely identifies a RenderFrame.
   struct RenderFrameIdKey {
@@ -74,6 +83,7 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       content::NavigationHandle* navigation_handle) override;
   void DidFinishNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // Invoked if an IPC message is coming from a specific RenderFrameHost.
   bool OnMessageReceived(const IPC::Message& message,
@@ -94,10 +104,36 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
 
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
+
+  void IncrementBlockedCount(const std::string& block_type);
+  void FlushBlockedCounts();
+#if !defined(OS_ANDROID)
+  void QueueBlockedEvent(const std::string& block_type,
+                         const std::string& subresource);
+  void DispatchPendingBlockedEvents();
+#endif
+
   std::vector<std::string> allowed_script_origins_;
-  // We keep a set of the current page's blocked URLs in case the page
-  // continually tries to load the same blocked URLs.
-  std::set<std::string> blocked_url_paths_;
+  // We keep 64-bit hashes of the current page's blocked URLs in case the page
+  // continually tries to load the same blocked URLs. Capped so that
+  // long-lived pages with endless blocked requests can't grow it unbounded.
+  std::unordered_set<uint64_t> blocked_subresource_hashes_;
+#if !defined(OS_ANDROID)
+  // (block type, subresource) pairs waiting to be sent to the extension as
+  // one onBlocked event, without duplicates.
+  std::vector<std::pair<std::string, std::string>> pending_blocked_events_;
+  base::flat_set<std::pair<std::string, std::string>>
+      pending_blocked_event_set_;
+  base::OneShotTimer blocked_events_timer_;
+#endif
+  // Blocked counts not yet committed to the profile's stats prefs. Pages can
+  // block hundreds of resources, so we write the prefs (and notify their
+  // observers) once per flush rather than once per resource.
+  uint64_t pending_ads_blocked_ = 0;
+  uint64_t pending_https_upgrades_ = 0;
+  uint64_t pending_javascript_blocked_ = 0;
+  uint64_t pending_fingerprinting_blocked_ = 0;
+  base::OneShotTimer stats_flush_timer_;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
@@ -0,0 +1,88 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+
+#include <memory>
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kShieldsSettingsCacheKey[] = "brave_shields_settings_cache";
+
+// Pages embedding content from many origins don't make the cache grow
+// without bound, it just starts over.
+const size_t kMaxCachedOrigins = 256;
+
+}  // namespace
+
+ShieldsSettingsCache::ShieldsSettingsCache(Profile* profile)
+    : profile_(profile),
+      host_content_settings_map_(
+          HostContentSettingsMapFactory::GetForProfile(profile)) {
+  host_content_settings_map_->AddObserver(this);
+}
+
+ShieldsSettingsCache::~ShieldsSettingsCache() {
+  host_content_settings_map_->RemoveObserver(this);
+}
+
+// static
+ShieldsSettingsCache* ShieldsSettingsCache::GetForProfile(Profile* profile) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  ShieldsSettingsCache* cache = static_cast<ShieldsSettingsCache*>(
+      profile->GetUserData(kShieldsSettingsCacheKey));
+
+  if (!cache) {
+    // Object cleanup is handled by SupportsUserData
+    profile->SetUserData(kShieldsSettingsCacheKey,
+                         std::make_unique<ShieldsSettingsCache>(profile));
+    cache = static_cast<ShieldsSettingsCache*>(
+        profile->GetUserData(kShieldsSettingsCacheKey));
+  }
+  return cache;
+}
+
+ShieldsSettings ShieldsSettingsCache::Get(const GURL& tab_origin) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto it = settings_by_origin_.find(tab_origin);
+  if (it != settings_by_origin_.end())
+    return it->second;
+
+  ShieldsSettings settings;
+  settings.shields_enabled = GetBraveShieldsEnabled(profile_, tab_origin);
+  settings.allow_ads =
+      GetAdControlType(profile_, tab_origin) == ControlType::ALLOW;
+  settings.allow_http_upgradable_resource =
+      !GetHTTPSEverywhereEnabled(profile_, tab_origin);
+  settings.allow_referrers = AllowReferrers(profile_, tab_origin);
+
+  if (settings_by_origin_.size() >= kMaxCachedOrigins)
+    settings_by_origin_.clear();
+  settings_by_origin_.emplace(tab_origin, settings);
+  return settings;
+}
+
+void ShieldsSettingsCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier) {
+  // All shields settings are stored as PLUGINS resources, DEFAULT means
+  // every type changed.
+  if (content_type == ContentSettingsType::PLUGINS ||
+      content_type == ContentSettingsType::DEFAULT) {
+    settings_by_origin_.clear();
+  }
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,62 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
+
+#include <map>
+#include <string>
+
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/supports_user_data.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "url/gurl.h"
+
+class HostContentSettingsMap;
+class Profile;
+
+namespace brave_shields {
+
+// The shields settings the network helpers need for a request, resolved for
+// the origin of the tab the request belongs to.
+struct ShieldsSettings {
+  bool shields_enabled = true;
+  bool allow_ads = false;
+  bool allow_http_upgradable_resource = false;
+  bool allow_referrers = false;
+};
+
+// Per-profile snapshot of ShieldsSettings keyed by tab origin. A page load
+// issues many requests for the same tab origin, so instead of doing four
+// content settings lookups for each request we resolve them once and keep
+// the result until any shields setting changes.
+class ShieldsSettingsCache : public base::SupportsUserData::Data,
+                             public content_settings::Observer {
+ public:
+  explicit ShieldsSettingsCache(Profile* profile);
+  ~ShieldsSettingsCache() override;
+
+  static ShieldsSettingsCache* GetForProfile(Profile* profile);
+
+  ShieldsSettings Get(const GURL& tab_origin);
+
+ private:
+  // content_settings::Observer overrides:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type,
+                               const std::string& resource_identifier) override;
+
+  Profile* profile_;  // NOT OWNED
+  scoped_refptr<HostContentSettingsMap> host_content_settings_map_;
+  std::map<GURL, ShieldsSettings> settings_by_origin_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
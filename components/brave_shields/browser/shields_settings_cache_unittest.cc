@@ -0,0 +1,71 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+
+#include "base/macros.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::ControlType;
+using brave_shields::ShieldsSettings;
+using brave_shields::ShieldsSettingsCache;
+
+class ShieldsSettingsCacheTest : public testing::Test {
+ public:
+  ShieldsSettingsCacheTest() = default;
+  ~ShieldsSettingsCacheTest() override = default;
+
+  void SetUp() override { profile_ = std::make_unique<TestingProfile>(); }
+
+  TestingProfile* profile() { return profile_.get(); }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsCacheTest);
+};
+
+TEST_F(ShieldsSettingsCacheTest, MatchesContentSettings) {
+  const GURL origin("https://brave.com/");
+  ShieldsSettingsCache* cache = ShieldsSettingsCache::GetForProfile(profile());
+  EXPECT_EQ(cache, ShieldsSettingsCache::GetForProfile(profile()));
+
+  ShieldsSettings settings = cache->Get(origin);
+  EXPECT_EQ(settings.shields_enabled,
+            brave_shields::GetBraveShieldsEnabled(profile(), origin));
+  EXPECT_EQ(settings.allow_ads,
+            brave_shields::GetAdControlType(profile(), origin) ==
+                ControlType::ALLOW);
+  EXPECT_EQ(settings.allow_http_upgradable_resource,
+            !brave_shields::GetHTTPSEverywhereEnabled(profile(), origin));
+  EXPECT_EQ(settings.allow_referrers,
+            brave_shields::AllowReferrers(profile(), origin));
+}
+
+TEST_F(ShieldsSettingsCacheTest, UpdatesWhenSettingsChange) {
+  const GURL origin("https://brave.com/");
+  const GURL other_origin("https://example.com/");
+  ShieldsSettingsCache* cache = ShieldsSettingsCache::GetForProfile(profile());
+
+  EXPECT_TRUE(cache->Get(origin).shields_enabled);
+  EXPECT_FALSE(cache->Get(origin).allow_ads);
+  EXPECT_TRUE(cache->Get(other_origin).shields_enabled);
+
+  brave_shields::SetBraveShieldsEnabled(profile(), false, origin);
+  EXPECT_FALSE(cache->Get(origin).shields_enabled);
+  EXPECT_TRUE(cache->Get(other_origin).shields_enabled);
+
+  brave_shields::SetAdControlType(profile(), ControlType::ALLOW, origin);
+  EXPECT_TRUE(cache->Get(origin).allow_ads);
+  EXPECT_FALSE(cache->Get(other_origin).allow_ads);
+
+  brave_shields::SetBraveShieldsEnabled(profile(), true, origin);
+  EXPECT_TRUE(cache->Get(origin).shields_enabled);
+}
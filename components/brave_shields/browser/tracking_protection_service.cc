@@ -5,18 +5,19 @@
 
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/command_line.h"
-#include "base/task/post_task.h"
 #include "base/task_runner_util.h"
 #include "brave/common/brave_switches.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
-#include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
+#include "base/stl_util.h"
 #include "base/strings/string_split.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/tracking_protection_helper.h"
@@ -31,13 +32,39 @@ namespace brave_shields {
 #if BUILDFLAG(BRAVE_STP_ENABLED)
 const char kDatFileVersion[] = "1";
 const char kStorageTrackersFile[] = "StorageTrackingProtection.dat";
+
+namespace {
+
+// Runs on the local data files task runner so that neither reading nor
+// indexing the list happens on the UI thread.
+std::unique_ptr<base::flat_set<std::string>> LoadStorageTrackers(
+    const base::FilePath& path) {
+  const std::string contents =
+      brave_component_updater::GetDATFileAsString(path);
+  if (contents.empty()) {
+    LOG(ERROR) << "Could not obtain first party trackers data";
+    return nullptr;
+  }
+
+  std::vector<std::string> storage_trackers =
+      base::SplitString(contents, ",", base::TRIM_WHITESPACE,
+                        base::SPLIT_WANT_NONEMPTY);
+  if (storage_trackers.empty()) {
+    LOG(ERROR) << "No first party trackers found";
+    return nullptr;
+  }
+
+  return std::make_unique<base::flat_set<std::string>>(
+      std::move(storage_trackers));
+}
+
+}  // namespace
 #endif
 
 TrackingProtectionService::TrackingProtectionService(
     LocalDataFilesService* local_data_files_service)
     : LocalDataFilesObserver(local_data_files_service),
-      weak_factory_(this),
-      weak_factory_io_thread_(this) {
+      weak_factory_(this) {
 }
 
 TrackingProtectionService::~TrackingProtectionService() {
@@ -80,9 +107,9 @@ void TrackingProtectionService::SetStartingSiteForRenderFrame(
     GURL starting_site,
     int render_process_id,
     int render_frame_id) {
-  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
   const RenderFrameIdKey key(render_process_id, render_frame_id);
-  render_frame_key_to_starting_site_url[key] = starting_site;
+  render_frame_key_to_starting_site_url_[key] = std::move(starting_site);
 }
 
 GURL TrackingProtectionService::GetStartingSiteForRenderFrame(
@@ -90,8 +117,8 @@ GURL TrackingProtectionService::GetStartingSiteForRenderFrame(
     int render_frame_id) const {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
   const RenderFrameIdKey key(render_process_id, render_frame_id);
-  auto iter = render_frame_key_to_starting_site_url.find(key);
-  if (iter != render_frame_key_to_starting_site_url.end()) {
+  auto iter = render_frame_key_to_starting_site_url_.find(key);
+  if (iter != render_frame_key_to_starting_site_url_.end()) {
     return iter->second;
   }
   return {};
@@ -101,22 +128,23 @@ void TrackingProtectionService::ModifyRenderFrameKey(int old_render_process_id,
                                                      int old_render_frame_id,
                                                      int new_render_process_id,
                                                      int new_render_frame_id) {
-  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
   const RenderFrameIdKey old_key(old_render_process_id, old_render_frame_id);
-  auto iter = render_frame_key_to_starting_site_url.find(old_key);
-  if (iter != render_frame_key_to_starting_site_url.end()) {
+  auto iter = render_frame_key_to_starting_site_url_.find(old_key);
+  if (iter != render_frame_key_to_starting_site_url_.end()) {
+    GURL starting_site = std::move(iter->second);
+    render_frame_key_to_starting_site_url_.erase(iter);
     const RenderFrameIdKey new_key(new_render_process_id, new_render_frame_id);
-    render_frame_key_to_starting_site_url.insert(
-        std::pair<RenderFrameIdKey, GURL>(new_key, iter->second));
-    render_frame_key_to_starting_site_url.erase(old_key);
+    render_frame_key_to_starting_site_url_.emplace(new_key,
+                                                   std::move(starting_site));
   }
 }
 
 void TrackingProtectionService::DeleteRenderFrameKey(int render_process_id,
                                                      int render_frame_id) {
-  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
   const RenderFrameIdKey key(render_process_id, render_frame_id);
-  render_frame_key_to_starting_site_url.erase(key);
+  render_frame_key_to_starting_site_url_.erase(key);
 }
 
 bool TrackingProtectionService::ShouldStoreState(HostContentSettingsMap* map,
@@ -129,7 +157,7 @@ bool TrackingProtectionService::ShouldStoreState(HostContentSettingsMap* map,
     return true;
   }
 
-  if (first_party_storage_trackers_.empty()) {
+  if (!first_party_storage_trackers_) {
     LOG(INFO) << "First party storage trackers list is empty";
     return true;
   }
@@ -153,36 +181,15 @@ bool TrackingProtectionService::ShouldStoreState(HostContentSettingsMap* map,
     return true;
 
   // deny storage if host is found in the tracker list
-  return first_party_storage_trackers_.find(host) ==
-         first_party_storage_trackers_.end();
+  return !base::Contains(*first_party_storage_trackers_, host);
 }
 
-void TrackingProtectionService::OnGetSTPDATFileData(std::string contents) {
-  if (contents.empty()) {
-    LOG(ERROR) << "Could not obtain first party trackers data";
-    return;
-  }
-
-  std::vector<std::string> storage_trackers =
-      base::SplitString(base::StringPiece(contents.data(), contents.size()),
-                        ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-
-  if (storage_trackers.empty()) {
-    LOG(ERROR) << "No first party trackers found";
-    return;
-  }
-
-  base::PostTask(
-      FROM_HERE, {BrowserThread::IO},
-      base::BindOnce(
-          &TrackingProtectionService::UpdateFirstPartyStorageTrackers,
-          weak_factory_io_thread_.GetWeakPtr(), std::move(storage_trackers)));
-}
-
-void TrackingProtectionService::UpdateFirstPartyStorageTrackers(
-    std::vector<std::string> storage_trackers) {
-  first_party_storage_trackers_ =
-      base::flat_set<std::string>(std::move(storage_trackers));
+void TrackingProtectionService::OnGetStorageTrackers(
+    std::unique_ptr<base::flat_set<std::string>> storage_trackers) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  // Keep the previous list if the new one failed to load.
+  if (storage_trackers)
+    first_party_storage_trackers_ = std::move(storage_trackers);
 }
 
 #else  // !BUILDFLAG(BRAVE_STP_ENABLED)
@@ -195,21 +202,6 @@ bool TrackingProtectionService::ShouldStoreState(HostContentSettingsMap* map,
 }
 #endif  // BUILDFLAG(BRAVE_STP_ENABLED)
 
-bool TrackingProtectionService::ShouldStartRequest(
-    const GURL& url,
-    blink::mojom::ResourceType resource_type,
-    const std::string& tab_host,
-    bool* matching_exception_filter,
-    bool* cancel_request_explicitly) {
-  DCHECK_CURRENTLY_ON(BrowserThread::IO);
-  // There are no exceptions in the TP service, but exceptions are
-  // combined with brave/ad-block.
-  if (matching_exception_filter) {
-    *matching_exception_filter = false;
-  }
-  return false;
-}
-
 void TrackingProtectionService::OnComponentReady(
     const std::string& component_id,
     const base::FilePath& install_dir,
@@ -225,9 +217,8 @@ void TrackingProtectionService::OnComponentReady(
   base::PostTaskAndReplyWithResult(
       local_data_files_service()->GetTaskRunner().get(),
       FROM_HERE,
-      base::BindOnce(&brave_component_updater::GetDATFileAsString,
-                     storage_tracking_protection_path),
-      base::BindOnce(&TrackingProtectionService::OnGetSTPDATFileData,
+      base::BindOnce(&LoadStorageTrackers, storage_tracking_protection_path),
+      base::BindOnce(&TrackingProtectionService::OnGetStorageTrackers,
                      weak_factory_.GetWeakPtr()));
 #endif
 }
@@ -6,21 +6,16 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_SERVICE_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_SERVICE_H_
 
-#include <map>
 #include <memory>
 #include <string>
-#include <utility>
-#include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
-#include "base/sequenced_task_runner.h"
-#include "base/synchronization/lock.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 #include "brave/components/brave_shields/browser/buildflags/buildflags.h"  // For STP
-#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
 
 class HostContentSettingsMap;
@@ -40,12 +35,6 @@ class TrackingProtectionService : public LocalDataFilesObserver {
 
   static bool IsSmartTrackingProtectionEnabled();
 
-  bool ShouldStartRequest(const GURL& spec,
-                          blink::mojom::ResourceType resource_type,
-                          const std::string& tab_host,
-                          bool* matching_exception_filter,
-                          bool* cancel_request_explicitly);
-
   // implementation of LocalDataFilesObserver
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir,
@@ -61,6 +50,8 @@ class TrackingProtectionService : public LocalDataFilesObserver {
                         const GURL& origin_url) const;
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
+  // Per-frame starting sites are only touched on the UI thread, by
+  // TrackingProtectionHelper and ShouldStoreState.
   void SetStartingSiteForRenderFrame(GURL starting_site,
                                      int render_process_id,
                                      int render_frame_id);
@@ -76,10 +67,10 @@ class TrackingProtectionService : public LocalDataFilesObserver {
 
  protected:
 #if BUILDFLAG(BRAVE_STP_ENABLED)
-  // ParseStorageTrackersData parses the storage trackers list provided by
-  // the offline-crawler
-  void OnGetSTPDATFileData(std::string contents);
-  void UpdateFirstPartyStorageTrackers(std::vector<std::string>);
+  // Swaps in the storage trackers set built on the local data files task
+  // runner from the list provided by the offline-crawler.
+  void OnGetStorageTrackers(
+      std::unique_ptr<base::flat_set<std::string>> storage_trackers);
 
   // For Smart Tracking Protection, we need to keep track of the starting site
   // that initiated the redirects. We use RenderFrameIdKey to determine the
@@ -98,16 +89,13 @@ class TrackingProtectionService : public LocalDataFilesObserver {
 
  private:
 #if BUILDFLAG(BRAVE_STP_ENABLED)
-  base::flat_set<std::string> first_party_storage_trackers_;
-  std::map<RenderFrameIdKey, GURL> render_frame_key_to_starting_site_url;
+  // Immutable once built; replaced as a whole when the list updates.
+  std::unique_ptr<const base::flat_set<std::string>>
+      first_party_storage_trackers_;
+  base::flat_map<RenderFrameIdKey, GURL> render_frame_key_to_starting_site_url_;
 #endif
 
-  std::vector<std::string> third_party_base_hosts_;
-  std::map<std::string, std::vector<std::string>> third_party_hosts_cache_;
-  base::Lock third_party_hosts_lock_;
-
   base::WeakPtrFactory<TrackingProtectionService> weak_factory_;
-  base::WeakPtrFactory<TrackingProtectionService> weak_factory_io_thread_;
   DISALLOW_COPY_AND_ASSIGN(TrackingProtectionService);
 };
 
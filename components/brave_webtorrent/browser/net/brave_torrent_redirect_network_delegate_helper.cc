@@ -45,6 +45,14 @@ bool IsMainFrameResource(std::shared_ptr<brave::BraveRequestInfo> ctx) {
 
 namespace webtorrent {
 
+brave::HelperFilter GetTorrentRedirectFilter() {
+  brave::HelperFilter filter("TorrentRedirect");
+  filter.resource_types = brave::HelperFilter::ResourceTypeBit(
+      blink::mojom::ResourceType::kMainFrame);
+  filter.mime_types = {kBittorrentMimeType, kOctetStreamMimeType};
+  return filter;
+}
+
 int OnHeadersReceived_TorrentRedirectWork(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
@@ -20,6 +20,10 @@ class URLRequest;
 
 namespace webtorrent {
 
+// Only main frame responses served as torrents (or as octet streams, which may
+// be .torrent files) can be redirected to the viewer.
+brave::HelperFilter GetTorrentRedirectFilter();
+
 int OnHeadersReceived_TorrentRedirectWork(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
@@ -335,3 +335,21 @@ TEST_F(BraveTorrentRedirectNetworkDelegateHelperTest,
   EXPECT_EQ(allowed_unsafe_redirect_url, GURL());
   EXPECT_EQ(rc, net::OK);
 }
+
+TEST_F(BraveTorrentRedirectNetworkDelegateHelperTest,
+       FilterMatchesRedirectableResponses) {
+  const brave::HelperFilter filter = webtorrent::GetTorrentRedirectFilter();
+
+  brave::BraveRequestInfo request_info(torrent_url());
+  request_info.resource_type = blink::mojom::ResourceType::kMainFrame;
+  EXPECT_TRUE(filter.MatchesRequest(request_info));
+  request_info.resource_type = blink::mojom::ResourceType::kSubFrame;
+  EXPECT_FALSE(filter.MatchesRequest(request_info));
+  request_info.resource_type = blink::mojom::ResourceType::kXhr;
+  EXPECT_FALSE(filter.MatchesRequest(request_info));
+
+  EXPECT_TRUE(filter.MatchesResponse(kBittorrentMimeType));
+  EXPECT_TRUE(filter.MatchesResponse(kOctetStreamMimeType));
+  EXPECT_FALSE(filter.MatchesResponse("text/html"));
+  EXPECT_FALSE(filter.MatchesResponse(""));
+}
@@ -5,9 +5,11 @@
 
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 
+#include <map>
 #include <memory>
 #include <utility>
 
+#include "base/auto_reset.h"
 #include "base/bind.h"
 #include "base/optional.h"
 #include "base/task/post_task.h"
@@ -28,6 +30,8 @@ namespace content_settings {
 
 namespace {
 
+using PatternPair = std::pair<ContentSettingsPattern, ContentSettingsPattern>;
+
 Rule CloneRule(const Rule& rule, bool reverse_patterns = false) {
   // brave plugin rules incorrectly use first party url as primary
   auto primary_pattern = reverse_patterns ? rule.secondary_pattern
@@ -79,7 +83,8 @@ class BraveShieldsRuleIterator : public RuleIterator {
 
 
 bool IsActive(const Rule& cookie_rule,
-              const std::vector<Rule>& shield_rules) {
+              const std::vector<Rule>& shield_rules,
+              bool has_shields_down_rules) {
   // don't include default rules in the iterator
   if (cookie_rule.primary_pattern == ContentSettingsPattern::Wildcard() &&
       (cookie_rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
@@ -89,6 +94,10 @@ bool IsActive(const Rule& cookie_rule,
   }
 
   bool default_value = true;
+  // Only shields down rules can deactivate a cookie rule.
+  if (!has_shields_down_rules)
+    return default_value;
+
   for (const auto& shield_rule : shield_rules) {
     auto primary_compare =
         shield_rule.primary_pattern.Compare(cookie_rule.primary_pattern);
@@ -339,8 +348,12 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
 
   // collect shield rules
   std::vector<Rule> shield_rules;
+  bool has_shields_down_rules = false;
   while (brave_shields_iterator && brave_shields_iterator->HasNext()) {
     shield_rules.emplace_back(CloneRule(brave_shields_iterator->Next()));
+    if (ValueToContentSetting(&shield_rules.back().value) ==
+        CONTENT_SETTING_BLOCK)
+      has_shields_down_rules = true;
   }
 
   brave_shields_iterator.reset();
@@ -354,7 +367,7 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
   // Matching cookie rules against shield rules.
   while (brave_cookies_iterator && brave_cookies_iterator->HasNext()) {
     auto rule = brave_cookies_iterator->Next();
-    if (IsActive(rule, shield_rules)) {
+    if (IsActive(rule, shield_rules, has_shields_down_rules)) {
       rules.emplace_back(CloneRule(rule, true));
       brave_cookie_rules_[incognito].emplace_back(CloneRule(rule, true));
     }
@@ -382,36 +395,35 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
   }
 
   // get the list of changes
+  // Rules are indexed by their patterns so that the diff stays
+  // O(n log n) for profiles with many site exceptions.
+  std::map<PatternPair, ContentSetting> old_rules_index;
+  for (const auto& old_rule : old_rules) {
+    old_rules_index.emplace(
+        PatternPair(old_rule.primary_pattern, old_rule.secondary_pattern),
+        ValueToContentSetting(&old_rule.value));
+  }
+
   std::vector<Rule> brave_cookie_updates;
+  std::map<PatternPair, ContentSetting> new_rules_index;
   for (const auto& new_rule : brave_cookie_rules_[incognito]) {
-    auto match = std::find_if(
-        old_rules.begin(),
-        old_rules.end(),
-        [&new_rule](const auto& old_rule) {
-          // we want an exact match here because any change to the rule
-          // is an update
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern &&
-                 ValueToContentSetting(&new_rule.value) ==
-                    ValueToContentSetting(&old_rule.value);
-        });
-    if (match == old_rules.end()) {
+    PatternPair patterns(new_rule.primary_pattern, new_rule.secondary_pattern);
+    const ContentSetting setting = ValueToContentSetting(&new_rule.value);
+    new_rules_index.emplace(patterns, setting);
+    // we want an exact match here because any change to the rule
+    // is an update
+    auto match = old_rules_index.find(patterns);
+    if (match == old_rules_index.end() || match->second != setting) {
       brave_cookie_updates.emplace_back(CloneRule(new_rule));
     }
   }
 
   // find any removed rules
   for (const auto& old_rule : old_rules) {
-    auto match = std::find_if(
-        brave_cookie_rules_[incognito].begin(),
-        brave_cookie_rules_[incognito].end(),
-        [&old_rule](const auto& new_rule) {
-          // we only care about the patterns here because we're looking
-          // for deleted rules, not changed rules
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern;
-        });
-    if (match == brave_cookie_rules_[incognito].end()) {
+    // we only care about the patterns here because we're looking
+    // for deleted rules, not changed rules
+    if (!new_rules_index.count(PatternPair(old_rule.primary_pattern,
+                                           old_rule.secondary_pattern))) {
       brave_cookie_updates.emplace_back(
           Rule(old_rule.primary_pattern,
                old_rule.secondary_pattern,
@@ -419,6 +431,10 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
     }
   }
 
+  // Nothing changed, so there is nobody to notify
+  if (brave_cookie_updates.empty())
+    return;
+
   // Notify brave cookie changes as ContentSettingsType::COOKIES
   if (content_type == ContentSettingsType::PLUGINS) {
     // PostTask here to avoid content settings autolock DCHECK
@@ -433,6 +449,7 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
 
 void BravePrefProvider::NotifyChanges(const std::vector<Rule>& rules,
                                       bool incognito) {
+  base::AutoReset<bool> notifying(&notifying_cookie_changes_, true);
   for (const auto& rule : rules) {
     Notify(rule.primary_pattern,
            rule.secondary_pattern,
@@ -457,6 +474,10 @@ void BravePrefProvider::OnContentSettingChanged(
     const ContentSettingsPattern& secondary_pattern,
     ContentSettingsType content_type,
     const std::string& resource_identifier) {
+  // Our own notifications don't change the underlying rules.
+  if (notifying_cookie_changes_)
+    return;
+
   if (content_type == ContentSettingsType::COOKIES ||
       (content_type == ContentSettingsType::PLUGINS &&
           (resource_identifier == brave_shields::kCookies ||
@@ -53,6 +53,8 @@ class BravePrefProvider : public PrefProvider,
   FRIEND_TEST_ALL_PREFIXES(BravePrefProviderTest, TestShieldsSettingsMigration);
   FRIEND_TEST_ALL_PREFIXES(BravePrefProviderTest,
                            TestShieldsSettingsMigrationVersion);
+  FRIEND_TEST_ALL_PREFIXES(BravePrefProviderTest,
+                           TestCookieRulesNotifyOnlyChangedPatterns);
   void MigrateShieldsSettings(bool incognito);
   void MigrateShieldsSettingsV1ToV2();
   void MigrateShieldsSettingsV1ToV2ForOneType(ContentSettingsType content_type,
@@ -74,6 +76,10 @@ class BravePrefProvider : public PrefProvider,
   std::map<bool /* is_incognito */, std::vector<Rule>> cookie_rules_;
   std::map<bool /* is_incognito */, std::vector<Rule>> brave_cookie_rules_;
 
+  // Set while we notify about our own cookie rule changes, so that they are
+  // not treated as new changes to rebuild the rules from.
+  bool notifying_cookie_changes_ = false;
+
   base::WeakPtrFactory<BravePrefProvider> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(BravePrefProvider);
@@ -4,14 +4,19 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/macros.h"
 #include "base/optional.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 #include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
 #include "components/content_settings/core/browser/content_settings_registry.h"
 #include "components/content_settings/core/common/content_settings.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
@@ -145,6 +150,34 @@ class ShieldsScriptSetting : public ShieldsSetting {
   }
 };
 
+class CookieChangesObserver : public Observer {
+ public:
+  CookieChangesObserver() = default;
+  ~CookieChangesObserver() override = default;
+
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type,
+                               const std::string& resource_identifier) override {
+    if (content_type != ContentSettingsType::COOKIES)
+      return;
+    changes_.emplace_back(primary_pattern, secondary_pattern);
+  }
+
+  const std::vector<std::pair<ContentSettingsPattern, ContentSettingsPattern>>&
+  changes() const {
+    return changes_;
+  }
+
+  void Reset() { changes_.clear(); }
+
+ private:
+  std::vector<std::pair<ContentSettingsPattern, ContentSettingsPattern>>
+      changes_;
+
+  DISALLOW_COPY_AND_ASSIGN(CookieChangesObserver);
+};
+
 }  // namespace
 
 class BravePrefProviderTest : public testing::Test {
@@ -336,4 +369,41 @@ TEST_F(BravePrefProviderTest, TestShieldsSettingsMigrationVersion) {
   provider.ShutdownOnUIThread();
 }
 
+TEST_F(BravePrefProviderTest, TestCookieRulesNotifyOnlyChangedPatterns) {
+  BravePrefProvider provider(testing_profile()->GetPrefs(),
+                             false /* incognito */,
+                             true /* store_last_modified */);
+  CookieChangesObserver observer;
+  provider.AddObserver(&observer);
+
+  // Lots of unrelated site exceptions.
+  for (int i = 0; i < 100; i++) {
+    const GURL url("https://site" + base::NumberToString(i) + ".com");
+    provider.SetWebsiteSetting(
+        ContentSettingsPattern::FromURL(url),
+        ContentSettingsPattern::Wildcard(), ContentSettingsType::PLUGINS,
+        brave_shields::kCookies, ContentSettingToValue(CONTENT_SETTING_BLOCK));
+  }
+  base::RunLoop().RunUntilIdle();
+  observer.Reset();
+
+  // Shields down for one of the sites.
+  const ContentSettingsPattern pattern =
+      ContentSettingsPattern::FromURL(GURL("https://brave.com"));
+  provider.SetWebsiteSetting(pattern, ContentSettingsPattern::Wildcard(),
+                             ContentSettingsType::PLUGINS,
+                             brave_shields::kBraveShields,
+                             ContentSettingToValue(CONTENT_SETTING_BLOCK));
+  base::RunLoop().RunUntilIdle();
+
+  // Only the shields down cookie rule for that site is reported.
+  ASSERT_EQ(1u, observer.changes().size());
+  EXPECT_EQ(ContentSettingsPattern::Wildcard(),
+            observer.changes()[0].first);
+  EXPECT_EQ(pattern, observer.changes()[0].second);
+
+  provider.RemoveObserver(&observer);
+  provider.ShutdownOnUIThread();
+}
+
 }  //  namespace content_settings
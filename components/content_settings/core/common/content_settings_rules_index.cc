@@ -0,0 +1,88 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/common/content_settings_rules_index.h"
+
+#include "base/strings/string_piece.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "net/base/url_util.h"
+
+namespace content_settings {
+
+ContentSettingsRulesIndex::ContentSettingsRulesIndex() = default;
+
+ContentSettingsRulesIndex::ContentSettingsRulesIndex(
+    const ContentSettingsForOneType& rules)
+    : rules_(rules) {
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    const ContentSettingsPattern& pattern = rules_[i].primary_pattern;
+    const std::string& host = pattern.GetHost();
+    // IPv6 literals are kept out of the host maps since they are not split
+    // into labels the way domains are.
+    if (pattern.MatchesAllHosts() || host.empty() || host[0] == '[') {
+      other_rules_.push_back(i);
+    } else if (pattern.HasDomainWildcard()) {
+      domain_rules_[host].push_back(i);
+    } else {
+      host_rules_[host].push_back(i);
+    }
+  }
+}
+
+ContentSettingsRulesIndex::~ContentSettingsRulesIndex() = default;
+
+const ContentSettingPatternSource* ContentSettingsRulesIndex::FindFirstMatch(
+    const GURL& primary_url,
+    const GURL& secondary_url) const {
+  size_t best = rules_.size();
+
+  FindFirstMatchInCandidates(other_rules_, primary_url, secondary_url, &best);
+
+  // ContentSettingsPattern::Matches ignores a trailing dot, so the buckets
+  // have to be looked up without it as well.
+  const base::StringPiece host = net::TrimEndingDot(primary_url.host_piece());
+  if (!host.empty()) {
+    auto host_it = host_rules_.find(host.as_string());
+    if (host_it != host_rules_.end()) {
+      FindFirstMatchInCandidates(host_it->second, primary_url, secondary_url,
+                                 &best);
+    }
+
+    // Check the host itself and every parent domain.
+    base::StringPiece domain(host);
+    while (!domain.empty() && !domain_rules_.empty()) {
+      auto domain_it = domain_rules_.find(domain.as_string());
+      if (domain_it != domain_rules_.end()) {
+        FindFirstMatchInCandidates(domain_it->second, primary_url,
+                                   secondary_url, &best);
+      }
+      const size_t dot = domain.find('.');
+      if (dot == base::StringPiece::npos)
+        break;
+      domain.remove_prefix(dot + 1);
+    }
+  }
+
+  return best < rules_.size() ? &rules_[best] : nullptr;
+}
+
+void ContentSettingsRulesIndex::FindFirstMatchInCandidates(
+    const std::vector<size_t>& candidates,
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    size_t* best) const {
+  for (size_t index : candidates) {
+    if (index >= *best)
+      return;
+    const ContentSettingPatternSource& rule = rules_[index];
+    if (rule.primary_pattern.Matches(primary_url) &&
+        rule.secondary_pattern.Matches(secondary_url)) {
+      *best = index;
+      return;
+    }
+  }
+}
+
+}  // namespace content_settings
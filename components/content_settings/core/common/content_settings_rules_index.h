@@ -0,0 +1,59 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_RULES_INDEX_H_
+#define BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_RULES_INDEX_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "components/content_settings/core/common/content_settings.h"
+#include "url/gurl.h"
+
+namespace content_settings {
+
+// Indexes rules of one content type by the host of their primary pattern, so
+// that looking up the rule for a URL only checks rules that could match it:
+// those for the exact host, for any of its parent domains and the ones that
+// are not bound to a host. Rules keep their original order, so the first
+// matching rule wins just like when walking the whole list.
+class ContentSettingsRulesIndex {
+ public:
+  ContentSettingsRulesIndex();
+  explicit ContentSettingsRulesIndex(const ContentSettingsForOneType& rules);
+  ~ContentSettingsRulesIndex();
+
+  ContentSettingsRulesIndex(const ContentSettingsRulesIndex&) = delete;
+  ContentSettingsRulesIndex& operator=(const ContentSettingsRulesIndex&) =
+      delete;
+
+  // Returns the first rule matching both urls or nullptr if there is none.
+  const ContentSettingPatternSource* FindFirstMatch(
+      const GURL& primary_url,
+      const GURL& secondary_url) const;
+
+  size_t size() const { return rules_.size(); }
+
+ private:
+  // Lowers |*best| to the first rule from |candidates| (ordered by rule
+  // position) matching both urls that comes before |*best|.
+  void FindFirstMatchInCandidates(const std::vector<size_t>& candidates,
+                                  const GURL& primary_url,
+                                  const GURL& secondary_url,
+                                  size_t* best) const;
+
+  ContentSettingsForOneType rules_;
+  // Rules for exactly one host, i.e. "brave.com".
+  std::unordered_map<std::string, std::vector<size_t>> host_rules_;
+  // Rules for a domain and its subdomains, i.e. "[*.]brave.com".
+  std::unordered_map<std::string, std::vector<size_t>> domain_rules_;
+  // Rules matching any host or that have no host at all.
+  std::vector<size_t> other_rules_;
+};
+
+}  // namespace content_settings
+
+#endif  // BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_RULES_INDEX_H_
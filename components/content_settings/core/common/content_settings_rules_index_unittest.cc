@@ -0,0 +1,126 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/common/content_settings_rules_index.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=ContentSettingsRulesIndexTest.*
+
+namespace content_settings {
+
+namespace {
+
+void AddRule(const std::string& primary,
+             const std::string& secondary,
+             ContentSetting setting,
+             ContentSettingsForOneType* rules) {
+  rules->emplace_back(ContentSettingsPattern::FromString(primary),
+                      ContentSettingsPattern::FromString(secondary),
+                      base::Value::FromUniquePtrValue(
+                          ContentSettingToValue(setting)),
+                      std::string(), false);
+}
+
+const ContentSettingPatternSource* FindFirstMatchInList(
+    const ContentSettingsForOneType& rules,
+    const GURL& primary_url,
+    const GURL& secondary_url) {
+  for (const auto& rule : rules) {
+    if (rule.primary_pattern.Matches(primary_url) &&
+        rule.secondary_pattern.Matches(secondary_url)) {
+      return &rule;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(ContentSettingsRulesIndexTest, EmptyRules) {
+  ContentSettingsRulesIndex index;
+  EXPECT_EQ(nullptr, index.FindFirstMatch(GURL("https://brave.com"),
+                                          GURL("https://brave.com")));
+}
+
+TEST(ContentSettingsRulesIndexTest, KeepsRulesPrecedence) {
+  ContentSettingsForOneType rules;
+  AddRule("https://sub.brave.com:443", "*", CONTENT_SETTING_ALLOW, &rules);
+  AddRule("[*.]brave.com", "https://firstparty.com", CONTENT_SETTING_ASK,
+          &rules);
+  AddRule("[*.]brave.com", "*", CONTENT_SETTING_BLOCK, &rules);
+  AddRule("*", "*", CONTENT_SETTING_DEFAULT, &rules);
+  ContentSettingsRulesIndex index(rules);
+
+  const GURL third_party("https://tracker.com");
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            index.FindFirstMatch(GURL("https://sub.brave.com"), third_party)
+                ->GetContentSetting());
+  EXPECT_EQ(CONTENT_SETTING_ASK,
+            index.FindFirstMatch(GURL("https://a.b.brave.com"),
+                                 GURL("https://firstparty.com"))
+                ->GetContentSetting());
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            index.FindFirstMatch(GURL("http://brave.com"), third_party)
+                ->GetContentSetting());
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            index.FindFirstMatch(GURL("https://notbrave.com"), third_party)
+                ->GetContentSetting());
+}
+
+TEST(ContentSettingsRulesIndexTest, MatchesLinearLookup) {
+  ContentSettingsForOneType rules;
+  for (int i = 0; i < 500; ++i) {
+    const std::string site = "site" + base::NumberToString(i) + ".com";
+    switch (i % 4) {
+      case 0:
+        AddRule("[*.]" + site, "*", CONTENT_SETTING_BLOCK, &rules);
+        break;
+      case 1:
+        AddRule("https://" + site, "*", CONTENT_SETTING_ALLOW, &rules);
+        break;
+      case 2:
+        AddRule("[*.]" + site, "[*.]" + site, CONTENT_SETTING_ALLOW, &rules);
+        break;
+      case 3:
+        AddRule("*", "https://" + site, CONTENT_SETTING_BLOCK, &rules);
+        break;
+    }
+  }
+  AddRule("file:///*", "*", CONTENT_SETTING_ALLOW, &rules);
+  AddRule("*", "*", CONTENT_SETTING_ASK, &rules);
+  ContentSettingsRulesIndex index(rules);
+  EXPECT_EQ(rules.size(), index.size());
+
+  for (int i = 0; i < 520; i += 3) {
+    const std::string site = "site" + base::NumberToString(i) + ".com";
+    for (const GURL& primary_url :
+         {GURL("https://" + site), GURL("http://www." + site),
+          GURL("https://" + site + "."), GURL("http://www." + site + "."),
+          GURL("file:///tmp/" + site)}) {
+      for (const GURL& secondary_url :
+           {GURL("https://" + site), GURL("https://cdn." + site),
+            GURL("https://site3.com")}) {
+        const ContentSettingPatternSource* expected =
+            FindFirstMatchInList(rules, primary_url, secondary_url);
+        const ContentSettingPatternSource* actual =
+            index.FindFirstMatch(primary_url, secondary_url);
+        ASSERT_TRUE(expected);
+        ASSERT_TRUE(actual);
+        EXPECT_EQ(expected->primary_pattern, actual->primary_pattern);
+        EXPECT_EQ(expected->secondary_pattern, actual->secondary_pattern);
+        EXPECT_EQ(expected->GetContentSetting(), actual->GetContentSetting());
+      }
+    }
+  }
+}
+
+}  // namespace content_settings
@@ -211,8 +211,8 @@ declare namespace chrome.windows {
 
 declare namespace chrome.braveShields {
   const onBlocked: {
-    addListener: (callback: (detail: BlockDetails) => void) => void
-    emit: (detail: BlockDetails) => void
+    addListener: (callback: (details: BlockDetails[]) => void) => void
+    emit: (details: BlockDetails[]) => void
   }
 
   const allowScriptsOnce: any
@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -33,6 +35,7 @@
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "chrome/common/chrome_paths.h"
+#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/extension_registry.h"
 #include "extensions/browser/extension_system.h"
@@ -55,7 +58,7 @@ namespace {
 // NOTE: The caller takes ownership of the directory at extension->path() on the
 // returned object.
 scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
-    greaselion::GreaselionRule* rule,
+    const greaselion::GreaselionRuleSnapshot& rule,
     const base::FilePath& extensions_dir) {
   base::FilePath install_temp_dir =
       extensions::file_util::GetInstallTempDir(extensions_dir);
@@ -84,7 +87,7 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   // public key.
   char raw[crypto::kSHA256Length] = {0};
   std::string key;
-  std::string script_name = rule->name();
+  std::string script_name = rule.name;
   const base::CommandLine& command_line =
       *base::CommandLine::ForCurrentProcess();
   if (!command_line.HasSwitch(switches::kUseGoUpdateDev) &&
@@ -105,11 +108,11 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   root->SetStringPath(extensions::manifest_keys::kPublicKey, key);
 
   auto js_files = std::make_unique<base::ListValue>();
-  for (auto script : rule->scripts())
+  for (const auto& script : rule.scripts)
     js_files->AppendString(script.BaseName().value());
 
   auto matches = std::make_unique<base::ListValue>();
-  for (auto url_pattern : rule->url_patterns())
+  for (const auto& url_pattern : rule.url_patterns)
     matches->AppendString(url_pattern);
 
   auto content_script = std::make_unique<base::DictionaryValue>();
@@ -117,7 +120,7 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   content_script->Set(extensions::manifest_keys::kJs, std::move(js_files));
   // All Greaselion scripts default to document end.
   content_script->SetStringPath(extensions::manifest_keys::kRunAt,
-      rule->run_at() == extensions::manifest_values::kRunAtDocumentStart
+      rule.run_at == extensions::manifest_values::kRunAtDocumentStart
         ? extensions::manifest_values::kRunAtDocumentStart
         : extensions::manifest_values::kRunAtDocumentEnd);
 
@@ -141,7 +144,7 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   }
 
   // Copy the script files to our extension directory.
-  for (auto script : rule->scripts()) {
+  for (const auto& script : rule.scripts) {
     if (!base::CopyFile(script, temp_dir.GetPath().Append(script.BaseName()))) {
       LOG(ERROR) << "Could not copy Greaselion script at path: "
           << script.LossyDisplayName();
@@ -161,10 +164,67 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   temp_dir.Take();  // The caller takes ownership of the directory.
   return extension;
 }
+
+// Hashes everything that ends up in the extension generated for a rule, so
+// that rules whose extension would come out the same are not converted and
+// reinstalled again. Returns an empty string if a script can't be read.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+std::string GetRuleHashOnTaskRunner(
+    const greaselion::GreaselionRuleSnapshot& rule) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  auto update = [&hash](const std::string& value) {
+    // Length prefixed so that different splits of the same bytes differ.
+    const uint64_t length = value.length();
+    hash->Update(&length, sizeof(length));
+    hash->Update(value.data(), value.length());
+  };
+
+  update(rule.name);
+  update(rule.run_at);
+  for (const auto& url_pattern : rule.url_patterns)
+    update(url_pattern);
+  for (const auto& script : rule.scripts) {
+    std::string contents;
+    if (!base::ReadFileToString(script, &contents)) {
+      LOG(ERROR) << "Could not read Greaselion script at path: "
+          << script.LossyDisplayName();
+      return std::string();
+    }
+    update(script.BaseName().AsUTF8Unsafe());
+    update(contents);
+  }
+
+  std::string result(crypto::kSHA256Length, 0);
+  hash->Finish(base::data(result), result.length());
+  return result;
+}
+
+std::vector<greaselion::GreaselionRuleSnapshot> GetRuleHashesOnTaskRunner(
+    std::vector<greaselion::GreaselionRuleSnapshot> rules) {
+  for (auto& rule : rules)
+    rule.hash = GetRuleHashOnTaskRunner(rule);
+  return rules;
+}
+
 }  // namespace
 
 namespace greaselion {
 
+GreaselionRuleSnapshot::GreaselionRuleSnapshot() = default;
+
+GreaselionRuleSnapshot::GreaselionRuleSnapshot(
+    const GreaselionRuleSnapshot& other) = default;
+
+GreaselionRuleSnapshot::GreaselionRuleSnapshot(GreaselionRuleSnapshot&& other) =
+    default;
+
+GreaselionRuleSnapshot& GreaselionRuleSnapshot::operator=(
+    GreaselionRuleSnapshot&& other) = default;
+
+GreaselionRuleSnapshot::~GreaselionRuleSnapshot() = default;
+
 GreaselionServiceImpl::GreaselionServiceImpl(
     GreaselionDownloadService* download_service,
     const base::FilePath& install_directory,
@@ -194,58 +254,105 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
   if (update_in_progress_)
     return;
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
+
+  // Hash the matching rules first so that only the ones that actually changed
+  // get converted and reinstalled.
+  std::vector<GreaselionRuleSnapshot> rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (rule->Matches(state_) && rule->has_unknown_preconditions() == false) {
+      GreaselionRuleSnapshot snapshot;
+      snapshot.name = rule->name();
+      snapshot.url_patterns = rule->url_patterns();
+      snapshot.scripts = rule->scripts();
+      snapshot.run_at = rule->run_at();
+      rules.push_back(std::move(snapshot));
+    }
+  }
+
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&GetRuleHashesOnTaskRunner, std::move(rules)),
+      base::BindOnce(&GreaselionServiceImpl::OnRuleHashesComputed,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void GreaselionServiceImpl::OnRuleHashesComputed(
+    std::vector<GreaselionRuleSnapshot> rules) {
+  DCHECK(update_in_progress_);
+  std::set<std::string> installed_hashes;
+  for (const auto& installed : greaselion_extensions_) {
+    if (!installed.second.empty())
+      installed_hashes.insert(installed.second);
+  }
+
+  rules_to_install_.clear();
+  std::set<std::string> wanted_hashes;
+  for (auto& rule : rules) {
+    // Rules whose scripts couldn't be read are always (re)converted so that
+    // the failure is reported.
+    if (!rule.hash.empty())
+      wanted_hashes.insert(rule.hash);
+    if (rule.hash.empty() || !installed_hashes.count(rule.hash))
+      rules_to_install_.push_back(std::move(rule));
+  }
+
+  // Extensions installed without a hash are never kept, so they get replaced
+  // rather than installed over.
+  DCHECK(extensions_to_unload_.empty());
+  for (const auto& installed : greaselion_extensions_) {
+    if (installed.second.empty() || !wanted_hashes.count(installed.second))
+      extensions_to_unload_.push_back(installed.first);
+  }
+
+  if (extensions_to_unload_.empty()) {
     CreateAndInstallExtensions();
     return;
   }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
+  // Make a copy of extensions_to_unload_ to iterate while the original vector
   // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
+  std::vector<extensions::ExtensionId> extensions = extensions_to_unload_;
   for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
+    // Outdated extensions have to be unloaded before their rules are
+    // installed again under the same id. OnExtensionUnloaded will be called on
+    // each extension, where we will update extensions_to_unload_. Once it's
+    // empty, that callback will call CreateAndInstallExtensions().
     extension_service_->UnloadExtension(
         id, extensions::UnloadedExtensionReason::UPDATE);
   }
 }
 
 void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+  DCHECK(extensions_to_unload_.empty());
   DCHECK(update_in_progress_);
   all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_) && rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
-    }
-  }
+  pending_installs_ = rules_to_install_.size();
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // nothing changed, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_) && rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule.get(), install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+
+  // The snapshots are converted rather than the current rules, which could
+  // have been reloaded while hashing.
+  std::vector<GreaselionRuleSnapshot> rules_to_install =
+      std::move(rules_to_install_);
+  rules_to_install_.clear();
+  for (const auto& rule : rules_to_install) {
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner, rule,
+                       install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), rule.hash));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
+    const std::string& rule_hash,
     scoped_refptr<extensions::Extension> extension) {
   if (!extension.get()) {
     all_rules_installed_successfully_ = false;
@@ -253,7 +360,7 @@ void GreaselionServiceImpl::PostConvert(
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(extension->id());
+    greaselion_extensions_[extension->id()] = rule_hash;
     extension_system_->ready().Post(
         FROM_HERE,
         base::BindOnce(&GreaselionServiceImpl::Install,
@@ -269,9 +376,7 @@ void GreaselionServiceImpl::Install(
 void GreaselionServiceImpl::OnExtensionReady(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!greaselion_extensions_.count(extension->id())) {
     // not one of ours
     return;
   }
@@ -284,14 +389,17 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension,
     extensions::UnloadedExtensionReason reason) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!greaselion_extensions_.erase(extension->id())) {
     // not one of ours
     return;
   }
-  greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
+
+  auto to_unload = std::find(extensions_to_unload_.begin(),
+                             extensions_to_unload_.end(), extension->id());
+  if (to_unload == extensions_to_unload_.end())
+    return;
+  extensions_to_unload_.erase(to_unload);
+  if (update_in_progress_ && extensions_to_unload_.empty()) {
     // It's time!
     CreateAndInstallExtensions();
   }
@@ -32,6 +32,25 @@ namespace greaselion {
 
 class GreaselionDownloadService;
 
+// Copy of a matching rule taken when an update starts, so the extension is
+// generated from the same contents that were hashed even if the rules are
+// reloaded in the meantime.
+struct GreaselionRuleSnapshot {
+  GreaselionRuleSnapshot();
+  GreaselionRuleSnapshot(const GreaselionRuleSnapshot& other);
+  GreaselionRuleSnapshot(GreaselionRuleSnapshot&& other);
+  GreaselionRuleSnapshot& operator=(GreaselionRuleSnapshot&& other);
+  ~GreaselionRuleSnapshot();
+
+  std::string name;
+  std::vector<std::string> url_patterns;
+  std::vector<base::FilePath> scripts;
+  std::string run_at;
+  // Hash of everything that ends up in the generated extension. Empty if a
+  // script couldn't be read.
+  std::string hash;
+};
+
 class GreaselionServiceImpl : public GreaselionService {
  public:
   explicit GreaselionServiceImpl(
@@ -57,8 +76,10 @@ class GreaselionServiceImpl : public GreaselionService {
                            extensions::UnloadedExtensionReason reason) override;
 
  private:
+  void OnRuleHashesComputed(std::vector<GreaselionRuleSnapshot> rules);
   void CreateAndInstallExtensions();
-  void PostConvert(scoped_refptr<extensions::Extension> extension);
+  void PostConvert(const std::string& rule_hash,
+                   scoped_refptr<extensions::Extension> extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
 
@@ -73,7 +94,14 @@ class GreaselionServiceImpl : public GreaselionService {
   int pending_installs_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
-  std::vector<extensions::ExtensionId> greaselion_extensions_;
+  // Every installed extension with the content hash of the rule it was
+  // generated from, which is empty if the hash couldn't be computed. Rules
+  // with an unchanged hash are not reinstalled.
+  std::map<extensions::ExtensionId, std::string> greaselion_extensions_;
+  // Outdated extensions that are being unloaded before installing
+  // |rules_to_install_|.
+  std::vector<extensions::ExtensionId> extensions_to_unload_;
+  std::vector<GreaselionRuleSnapshot> rules_to_install_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(GreaselionServiceImpl);
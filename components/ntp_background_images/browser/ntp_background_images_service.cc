@@ -40,6 +40,8 @@ namespace ntp_background_images {
 namespace {
 
 constexpr int kSIComponentUpdateCheckIntervalHours = 1;
+// Logo, current wallpaper and the preloaded next wallpaper.
+constexpr size_t kImageDataCacheSize = 3;
 constexpr char kNTPManifestFile[] = "photo.json";
 constexpr char kNTPSRMappingTableFile[] = "mapping-table.json";
 
@@ -133,6 +135,7 @@ NTPBackgroundImagesService::NTPBackgroundImagesService(
       local_pref_(local_pref),
       super_referral_cache_dir_(
           user_data_dir.AppendASCII("SuperReferralCache")),
+      image_data_cache_(kImageDataCacheSize),
       weak_factory_(this) {
 }
 
@@ -428,6 +431,25 @@ bool NTPBackgroundImagesService::HasObserver(Observer* observer) {
   return observer_list_.HasObserver(observer);
 }
 
+scoped_refptr<base::RefCountedMemory>
+NTPBackgroundImagesService::GetCachedImageData(
+    const base::FilePath& image_file) {
+  auto it = image_data_cache_.Get(image_file);
+  if (it == image_data_cache_.end())
+    return nullptr;
+  return it->second;
+}
+
+void NTPBackgroundImagesService::CacheImageData(
+    const base::FilePath& image_file,
+    scoped_refptr<base::RefCountedMemory> data,
+    int generation) {
+  // Read from files that could have been replaced since.
+  if (generation != image_data_cache_generation_)
+    return;
+  image_data_cache_.Put(image_file, std::move(data));
+}
+
 NTPBackgroundImagesData*
 NTPBackgroundImagesService::GetBackgroundImagesData(bool super_referral) const {
   const bool is_sr_enabled =
@@ -480,6 +502,10 @@ void NTPBackgroundImagesService::OnComponentReady(
 void NTPBackgroundImagesService::OnGetComponentJsonData(
     bool is_super_referral,
     const std::string& json_string) {
+  // Files could be replaced in place (ex, super referral cache dir).
+  image_data_cache_.Clear();
+  ++image_data_cache_generation_;
+
   if (is_super_referral) {
     local_pref_->SetBoolean(
           prefs::kNewTabPageGetInitialSRComponentInProgress,
@@ -10,8 +10,10 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/timer/timer.h"
@@ -69,6 +71,20 @@ class NTPBackgroundImagesService {
 
   std::vector<std::string> GetCachedTopSitesFaviconList() const;
 
+  // Image files are kept in memory once read so that every NTP (of every
+  // profile) doesn't read the same wallpaper from disk again. Only the logo,
+  // the wallpaper being shown and the next one that is preloaded are kept.
+  // The cache is dropped whenever component data is updated, which also bumps
+  // the generation so that reads started before that are not cached.
+  scoped_refptr<base::RefCountedMemory> GetCachedImageData(
+      const base::FilePath& image_file);
+  int image_data_cache_generation() const {
+    return image_data_cache_generation_;
+  }
+  void CacheImageData(const base::FilePath& image_file,
+                      scoped_refptr<base::RefCountedMemory> data,
+                      int generation);
+
  private:
   friend class TestNTPBackgroundImagesService;
   friend class NTPBackgroundImagesServiceTest;
@@ -107,6 +123,7 @@ class NTPBackgroundImagesService {
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, BasicTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
                            BasicSuperReferralDataTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, ImageDataCacheTest);
 
   void OnComponentReady(bool is_super_referral,
                         const base::FilePath& installed_dir);
@@ -144,6 +161,9 @@ class NTPBackgroundImagesService {
   base::ObserverList<Observer>::Unchecked observer_list_;
   std::unique_ptr<NTPBackgroundImagesData> si_images_data_;
   std::unique_ptr<NTPBackgroundImagesData> sr_images_data_;
+  base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      image_data_cache_;
+  int image_data_cache_generation_ = 0;
   PrefChangeRegistrar pref_change_registrar_;
   // This is only used for registration during initial(first) SR component
   // download. After initial download is done, it's cached to
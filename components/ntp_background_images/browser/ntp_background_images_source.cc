@@ -23,11 +23,12 @@ namespace ntp_background_images {
 
 namespace {
 
-base::Optional<std::string> ReadFileToString(const base::FilePath& path) {
+scoped_refptr<base::RefCountedMemory> ReadFileToBytes(
+    const base::FilePath& path) {
   std::string contents;
   if (!base::ReadFileToString(path, &contents))
-    return base::Optional<std::string>();
-  return contents;
+    return nullptr;
+  return base::RefCountedString::TakeString(&contents);
 }
 
 bool IsSuperReferralPath(const std::string& path) {
@@ -76,39 +77,56 @@ void NTPBackgroundImagesSource::StartDataRequest(
     return;
   }
 
-  base::FilePath image_file_path;
   if (IsLogoPath(path)) {
-    image_file_path = images_data->logo_image_file;
-  } else {
-    DCHECK(IsWallpaperPath(path));
-    image_file_path =
-        images_data->backgrounds[GetWallpaperIndexFromPath(path)].image_file;
+    GetImageFile(images_data->logo_image_file, std::move(callback));
+    return;
   }
 
-  GetImageFile(image_file_path, std::move(callback));
+  DCHECK(IsWallpaperPath(path));
+  const int wallpaper_index = GetWallpaperIndexFromPath(path);
+  GetImageFile(images_data->backgrounds[wallpaper_index].image_file,
+               std::move(callback));
+
+  // Wallpapers are shown in turn, so the next one will most likely be
+  // requested by the next NTP.
+  const int next_wallpaper_index =
+      (wallpaper_index + 1) % images_data->backgrounds.size();
+  if (next_wallpaper_index != wallpaper_index) {
+    GetImageFile(images_data->backgrounds[next_wallpaper_index].image_file,
+                 GotDataCallback());
+  }
 }
 
 void NTPBackgroundImagesSource::GetImageFile(
     const base::FilePath& image_file_path,
     GotDataCallback callback) {
+  if (auto bytes = service_->GetCachedImageData(image_file_path)) {
+    if (callback)
+      std::move(callback).Run(std::move(bytes));
+    return;
+  }
+
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&ReadFileToString, image_file_path),
+      base::BindOnce(&ReadFileToBytes, image_file_path),
       base::BindOnce(&NTPBackgroundImagesSource::OnGotImageFile,
                      weak_factory_.GetWeakPtr(),
+                     image_file_path,
+                     service_->image_data_cache_generation(),
                      std::move(callback)));
 }
 
 void NTPBackgroundImagesSource::OnGotImageFile(
+    const base::FilePath& image_file_path,
+    int cache_generation,
     GotDataCallback callback,
-    base::Optional<std::string> input) {
-  if (!input)
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  if (!bytes)
     return;
 
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-       reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
-  std::move(callback).Run(std::move(bytes));
+  service_->CacheImageData(image_file_path, bytes, cache_generation);
+  if (callback)
+    std::move(callback).Run(std::move(bytes));
 }
 
 std::string NTPBackgroundImagesSource::GetMimeType(const std::string& path) {
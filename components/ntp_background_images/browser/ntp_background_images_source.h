@@ -8,8 +8,8 @@
 
 #include <string>
 
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
-#include "base/optional.h"
 #include "content/public/browser/url_data_source.h"
 
 namespace base {
@@ -35,6 +35,7 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, BasicTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
                            BasicSuperReferralDataTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, ImageDataCacheTest);
 
   // content::URLDataSource overrides:
   std::string GetSource() override;
@@ -44,10 +45,13 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   std::string GetMimeType(const std::string& path) override;
   bool AllowCaching() override;
 
+  // |callback| can be null when the file is only preloaded into the cache.
   void GetImageFile(const base::FilePath& image_file_path,
                     GotDataCallback callback);
-  void OnGotImageFile(GotDataCallback callback,
-                      base::Optional<std::string> input);
+  void OnGotImageFile(const base::FilePath& image_file_path,
+                      int cache_generation,
+                      GotDataCallback callback,
+                      scoped_refptr<base::RefCountedMemory> bytes);
   bool IsValidPath(const std::string& path) const;
   bool IsLogoPath(const std::string& path) const;
   bool IsWallpaperPath(const std::string& path) const;
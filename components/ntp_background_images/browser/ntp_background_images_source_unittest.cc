@@ -6,6 +6,12 @@
 #include <memory>
 #include <string>
 
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/test/task_environment.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -15,6 +21,7 @@
 #include "brave/components/ntp_background_images/common/pref_names.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
 
 namespace ntp_background_images {
 
@@ -33,7 +40,7 @@ class NTPBackgroundImagesSourceTest : public testing::Test {
                     base::Value(base::Value::Type::DICTIONARY));
   }
 
-  base::test::SingleThreadTaskEnvironment task_environment;
+  base::test::TaskEnvironment task_environment;
   TestingPrefServiceSimple local_pref_;
   std::unique_ptr<NTPBackgroundImagesService> service_;
   std::unique_ptr<NTPBackgroundImagesSource> source_;
@@ -79,6 +86,84 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicTest) {
       source_->GetWallpaperIndexFromPath("sponsored-images/wallpaper-3.jpg"));
 }
 
+TEST_F(NTPBackgroundImagesSourceTest, ImageDataCacheTest) {
+  base::ScopedTempDir installed_dir;
+  ASSERT_TRUE(installed_dir.CreateUniqueTempDir());
+  const base::FilePath wallpaper_0 =
+      installed_dir.GetPath().AppendASCII("background-1.jpg");
+  const base::FilePath wallpaper_1 =
+      installed_dir.GetPath().AppendASCII("background-2.jpg");
+  ASSERT_EQ(2, base::WriteFile(wallpaper_0, "w0", 2));
+  ASSERT_EQ(2, base::WriteFile(wallpaper_1, "w1", 2));
+
+  const std::string test_json_string = R"(
+      {
+        "schemaVersion": 1,
+        "logo": {
+          "imageUrl": "logo.png",
+          "alt": "Technikke: For music lovers",
+          "companyName": "Technikke",
+          "destinationUrl": "https://www.brave.com/?from-super-referreer-demo"
+        },
+        "wallpapers": [
+          { "imageUrl": "background-1.jpg" },
+          { "imageUrl": "background-2.jpg" }
+        ]
+      })";
+  service_->si_installed_dir_ = installed_dir.GetPath();
+  service_->OnGetComponentJsonData(false, test_json_string);
+
+  auto request = [this](const std::string& path) {
+    std::string data;
+    base::RunLoop run_loop;
+    source_->StartDataRequest(
+        GURL("chrome://branded-wallpaper/" + path),
+        content::WebContents::Getter(),
+        base::BindOnce(
+            [](std::string* data, base::OnceClosure quit,
+               scoped_refptr<base::RefCountedMemory> bytes) {
+              if (bytes)
+                data->assign(bytes->front_as<char>(), bytes->size());
+              std::move(quit).Run();
+            },
+            &data, run_loop.QuitClosure()));
+    run_loop.Run();
+    return data;
+  };
+
+  // Serving the first wallpaper also preloads the next one.
+  EXPECT_EQ("w0", request("sponsored-images/wallpaper-0.jpg"));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(service_->GetCachedImageData(wallpaper_0));
+  EXPECT_TRUE(service_->GetCachedImageData(wallpaper_1));
+
+  // Later requests don't touch the disk.
+  ASSERT_TRUE(base::DeleteFile(wallpaper_1, false));
+  EXPECT_EQ("w1", request("sponsored-images/wallpaper-1.jpg"));
+
+  // Updated component data drops the cache, and reads that started before
+  // the update aren't cached afterwards.
+  const int old_generation = service_->image_data_cache_generation();
+  service_->OnGetComponentJsonData(false, test_json_string);
+  EXPECT_FALSE(service_->GetCachedImageData(wallpaper_0));
+  EXPECT_FALSE(service_->GetCachedImageData(wallpaper_1));
+  service_->CacheImageData(wallpaper_0, new base::RefCountedString(),
+                           old_generation);
+  EXPECT_FALSE(service_->GetCachedImageData(wallpaper_0));
+
+  // Only the logo and the current and next wallpapers are kept.
+  const int generation = service_->image_data_cache_generation();
+  for (int i = 0; i < 4; ++i) {
+    service_->CacheImageData(
+        installed_dir.GetPath().AppendASCII(base::NumberToString(i)),
+        new base::RefCountedString(), generation);
+  }
+  EXPECT_FALSE(service_->GetCachedImageData(
+      installed_dir.GetPath().AppendASCII("0")));
+  EXPECT_TRUE(service_->GetCachedImageData(
+      installed_dir.GetPath().AppendASCII("3")));
+}
+
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 
 #if !defined(OS_LINUX)
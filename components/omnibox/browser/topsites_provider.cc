@@ -9,7 +9,11 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 
+#include "base/containers/flat_map.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
@@ -21,6 +25,12 @@
 // Search Secondary Provider (suggestion)                              |  100++
 const int TopSitesProvider::kRelevance = 100;
 
+namespace {
+
+// Inputs up to this length are contained in a large part of the list.
+constexpr size_t kMaxPrecomputedInputLength = 2;
+
+}  // namespace
 
 TopSitesProvider::TopSitesProvider(AutocompleteProviderClient* client)
     : AutocompleteProvider(AutocompleteProvider::TYPE_SEARCH), client_(client) {
@@ -42,16 +52,13 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
 
-  for (std::vector<std::string>::const_iterator i = top_sites_.begin();
-       (i != top_sites_.end()) && (matches_.size() < provider_max_matches());
-       ++i) {
-    const std::string &current_site = *i;
+  for (size_t index : GetMatchingSites(input_text, provider_max_matches())) {
+    const std::string &current_site = top_sites_[index];
     size_t foundPos = current_site.find(input_text);
-    if (std::string::npos != foundPos) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text, current_site, foundPos);
-      AddMatch(base::ASCIIToUTF16(current_site), styles);
-    }
+    DCHECK_NE(std::string::npos, foundPos);
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text, current_site, foundPos);
+    AddMatch(base::ASCIIToUTF16(current_site), styles);
   }
 
   for (size_t i = 0; i < matches_.size(); ++i) {
@@ -70,6 +77,78 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
 
 TopSitesProvider::~TopSitesProvider() {}
 
+// static
+std::vector<size_t> TopSitesProvider::GetMatchingSites(
+    const std::string& input_text,
+    size_t max_matches) {
+  // Short inputs match so many sites that collecting and sorting them on each
+  // keystroke is slow, so the sites containing every substring of up to
+  // |kMaxPrecomputedInputLength| characters are listed ahead of time, already
+  // in list order.
+  static const base::NoDestructor<
+      base::flat_map<std::string, std::vector<size_t>>>
+      short_input_sites([] {
+        base::flat_map<std::string, std::vector<size_t>> result;
+        for (size_t i = 0; i < top_sites_.size(); ++i) {
+          const std::string& site = top_sites_[i];
+          for (size_t offset = 0; offset < site.size(); ++offset) {
+            for (size_t length = 1; length <= kMaxPrecomputedInputLength &&
+                                    offset + length <= site.size();
+                 ++length) {
+              std::vector<size_t>& sites = result[site.substr(offset, length)];
+              if (sites.empty() || sites.back() != i)
+                sites.push_back(i);
+            }
+          }
+        }
+        return result;
+      }());
+
+  if (!input_text.empty() &&
+      input_text.size() <= kMaxPrecomputedInputLength) {
+    auto it = short_input_sites->find(input_text);
+    if (it == short_input_sites->end())
+      return std::vector<size_t>();
+    const std::vector<size_t>& sites = it->second;
+    return std::vector<size_t>(
+        sites.begin(), sites.begin() + std::min(max_matches, sites.size()));
+  }
+
+  // Every suffix of every site, sorted, so that the sites containing the
+  // input are a single contiguous range found by binary search instead of
+  // running a substring search over the whole list on each keystroke.
+  using SiteSuffix = std::pair<base::StringPiece, size_t>;
+  static const base::NoDestructor<std::vector<SiteSuffix>> suffixes([] {
+    std::vector<SiteSuffix> result;
+    for (size_t i = 0; i < top_sites_.size(); ++i) {
+      base::StringPiece site(top_sites_[i]);
+      for (size_t offset = 0; offset < site.size(); ++offset)
+        result.emplace_back(site.substr(offset), i);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }());
+
+  auto it = std::lower_bound(
+      suffixes->begin(), suffixes->end(), input_text,
+      [](const SiteSuffix& suffix, const std::string& text) {
+        return suffix.first < text;
+      });
+  std::vector<size_t> sites;
+  for (; it != suffixes->end() &&
+         base::StartsWith(it->first, input_text, base::CompareCase::SENSITIVE);
+       ++it) {
+    sites.push_back(it->second);
+  }
+
+  // Keep the ranking of the list and report every site only once.
+  std::sort(sites.begin(), sites.end());
+  sites.erase(std::unique(sites.begin(), sites.end()), sites.end());
+  if (sites.size() > max_matches)
+    sites.resize(max_matches);
+  return sites;
+}
+
 // static
 ACMatchClassifications TopSitesProvider::StylesForSingleMatch(
     const std::string &input_text,
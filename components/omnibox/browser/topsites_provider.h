@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/compiler_specific.h"
+#include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/strings/string16.h"
 #include "components/omnibox/browser/autocomplete_match.h"
@@ -28,9 +29,16 @@ class TopSitesProvider : public AutocompleteProvider {
  private:
   ~TopSitesProvider() override;
 
+  FRIEND_TEST_ALL_PREFIXES(TopSitesProviderTest, IndexMatchesLinearScan);
+
   static const int kRelevance;
 
-  static std::vector<std::string> top_sites_;
+  static const std::vector<std::string> top_sites_;
+
+  // Returns indices into |top_sites_| of up to |max_matches| sites containing
+  // |input_text|, in list order.
+  static std::vector<size_t> GetMatchingSites(const std::string& input_text,
+                                              size_t max_matches);
 
   void AddMatch(const base::string16& match_string,
                 const ACMatchClassifications& styles);
@@ -6,7 +6,7 @@
 #include <stddef.h>
 
 
-std::vector<std::string> TopSitesProvider::top_sites_ = {
+const std::vector<std::string> TopSitesProvider::top_sites_ = {
   "google.com",
   "gmail.com",
   "mail.google.com",
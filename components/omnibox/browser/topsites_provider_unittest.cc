@@ -51,6 +51,37 @@ TEST_F(TopSitesProviderTest, SmokeTest) {
   EXPECT_TRUE(provider_->matches().empty());
 }
 
+// Simulates typing every site of the list character by character and checks
+// that the index returns the same sites as scanning the whole list would.
+TEST_F(TopSitesProviderTest, IndexMatchesLinearScan) {
+  const size_t kMaxMatches = 3;
+  auto linear_scan = [&](const std::string& input_text) {
+    std::vector<size_t> sites;
+    for (size_t i = 0;
+         i < TopSitesProvider::top_sites_.size() && sites.size() < kMaxMatches;
+         ++i) {
+      if (TopSitesProvider::top_sites_[i].find(input_text) != std::string::npos)
+        sites.push_back(i);
+    }
+    return sites;
+  };
+
+  for (const std::string& site : TopSitesProvider::top_sites_) {
+    for (size_t length = 1; length <= site.length(); ++length) {
+      const std::string input_text = site.substr(0, length);
+      EXPECT_EQ(linear_scan(input_text),
+                TopSitesProvider::GetMatchingSites(input_text, kMaxMatches))
+          << input_text;
+    }
+  }
+
+  for (const char* input_text : {"e.", "x", "dex", ".co", "zzzz", "le.com"}) {
+    EXPECT_EQ(linear_scan(input_text),
+              TopSitesProvider::GetMatchingSites(input_text, kMaxMatches))
+        << input_text;
+  }
+}
+
 TEST_F(TopSitesProviderTest, NoMatchingWhenPrefIsOff) {
   prefs()->SetBoolean(kTopSiteSuggestionsEnabled, false);
   provider_->Start(CreateAutocompleteInput("dex"), false);
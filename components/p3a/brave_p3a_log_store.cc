@@ -5,6 +5,7 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include "base/bind.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
@@ -20,6 +21,10 @@ constexpr char kLogValueKey[] = "value";
 constexpr char kLogSentKey[] = "sent";
 constexpr char kLogTimestampKey[] = "timestamp";
 
+// Histograms tend to be updated in bursts (e.g. on startup), so pref writes
+// are delayed a bit to commit the whole burst at once.
+constexpr base::TimeDelta kCommitDelay = base::TimeDelta::FromSeconds(5);
+
 void RecordP3A(uint64_t answers_count) {
   int answer = 0;
   if (1 <= answers_count && answers_count < 5) {
@@ -41,7 +46,9 @@ BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
   DCHECK(local_state);
 }
 
-BraveP3ALogStore::~BraveP3ALogStore() = default;
+BraveP3ALogStore::~BraveP3ALogStore() {
+  CommitDirtyEntries();
+}
 
 void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterDictionaryPref(kPrefName);
@@ -56,27 +63,18 @@ void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
     unsent_entries_.insert(histogram_name);
   }
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  MarkDirty(histogram_name);
 }
 
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
       DCHECK(!unsent_entries_.contains(pair.first));
 
       pair.second.ResetSentState();
-
-      // Update persistent values.
-      update->SetPath({pair.first, kLogSentKey}, base::Value(pair.second.sent));
-      update->SetPath({pair.first, kLogTimestampKey},
-                      base::Value(pair.second.sent_timestamp.ToDoubleT()));
+      MarkDirty(pair.first);
     }
   }
 
@@ -137,13 +135,7 @@ void BraveP3ALogStore::DiscardStagedLog() {
   auto log_iter = log_.find(staged_entry_key_);
   DCHECK(log_iter != log_.end());
   log_iter->second.MarkAsSent();
-
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+  MarkDirty(log_iter->first);
 
   // Erase the entry from the unsent queue.
   auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
@@ -155,7 +147,7 @@ void BraveP3ALogStore::DiscardStagedLog() {
 }
 
 void BraveP3ALogStore::PersistUnsentLogs() const {
-  NOTREACHED();
+  CommitDirtyEntries();
 }
 
 void BraveP3ALogStore::LoadPersistedUnsentLogs() {
@@ -211,4 +203,36 @@ void BraveP3ALogStore::LoadPersistedUnsentLogs() {
   }
 }
 
+void BraveP3ALogStore::MarkDirty(const std::string& histogram_name) {
+  dirty_entries_.insert(histogram_name);
+  if (!commit_timer_.IsRunning()) {
+    commit_timer_.Start(
+        FROM_HERE, kCommitDelay,
+        base::BindOnce(&BraveP3ALogStore::CommitDirtyEntries,
+                       base::Unretained(this)));
+  }
+}
+
+void BraveP3ALogStore::CommitDirtyEntries() const {
+  commit_timer_.Stop();
+  if (dirty_entries_.empty()) {
+    return;
+  }
+
+  DictionaryPrefUpdate update(local_state_, kPrefName);
+  for (const std::string& name : dirty_entries_) {
+    auto iter = log_.find(name);
+    if (iter == log_.end()) {
+      continue;
+    }
+    const LogEntry& entry = iter->second;
+    update->SetPath({name, kLogValueKey},
+                    base::Value(base::NumberToString(entry.value)));
+    update->SetPath({name, kLogSentKey}, base::Value(entry.sent));
+    update->SetPath({name, kLogTimestampKey},
+                    base::Value(entry.sent_timestamp.ToDoubleT()));
+  }
+  dirty_entries_.clear();
+}
+
 }  // namespace brave
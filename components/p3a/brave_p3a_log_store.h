@@ -12,6 +12,7 @@
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/metrics/log_store.h"
 
 class PrefService;
@@ -19,10 +20,12 @@ class PrefRegistrySimple;
 
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
-// All logs (not only unsent are persistent), and all logs could be loaded
-// using |LoadPersistedUnsentLogs()|. We should fix this at some point since
-// for now persisted entries never expire.
+// Stores all given values in memory and persists in prefs in batches: changed
+// entries are collected and committed with a single pref update shortly after
+// the first change (or on destruction). All logs (not only unsent ones) are
+// persistent, and all logs could be loaded using |LoadPersistedUnsentLogs()|.
+// We should fix this at some point since for now persisted entries never
+// expire.
 class BraveP3ALogStore : public metrics::LogStore {
  public:
   class Delegate {
@@ -56,8 +59,8 @@ class BraveP3ALogStore : public metrics::LogStore {
   void StageNextLog() override;
   void DiscardStagedLog() override;
 
-  // |PersistUnsentLogs| should not be used, since we persist everything
-  // on the fly.
+  // Commits all pending changes to prefs right away. Normally this happens
+  // automatically shortly after a change.
   void PersistUnsentLogs() const override;
   // Returns early if founds malformed persisted values.
   void LoadPersistedUnsentLogs() override;
@@ -80,6 +83,13 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  // Marks |histogram_name| as changed and schedules a pref commit.
+  void MarkDirty(const std::string& histogram_name);
+  // Writes the dirty entries to prefs. This is const only because
+  // metrics::LogStore::PersistUnsentLogs() is: it doesn't change any logs,
+  // only the bookkeeping of what's already in prefs, which is mutable.
+  void CommitDirtyEntries() const;
+
   const Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
@@ -87,6 +97,11 @@ class BraveP3ALogStore : public metrics::LogStore {
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
 
+  // Entries that changed since the last pref commit. Mutable for
+  // CommitDirtyEntries().
+  mutable base::flat_set<std::string> dirty_entries_;
+  mutable base::OneShotTimer commit_timer_;
+
   std::string staged_entry_key_;
   std::string staged_log_;
 
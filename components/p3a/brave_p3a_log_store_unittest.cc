@@ -0,0 +1,131 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "base/bind.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+constexpr char kPrefName[] = "p3a.logs";
+constexpr base::TimeDelta kCommitDelay = base::TimeDelta::FromSeconds(5);
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) const override {
+    return base::StrCat({histogram_name, "=", base::NumberToString(value)});
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public testing::Test {
+ public:
+  BraveP3ALogStoreTest() {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+    registrar_.Init(&local_state_);
+    registrar_.Add(kPrefName,
+                   base::BindRepeating(&BraveP3ALogStoreTest::OnLogsChanged,
+                                       base::Unretained(this)));
+    log_store_ = std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+  }
+
+ protected:
+  void OnLogsChanged() { ++pref_writes_; }
+
+  // Stages and discards every unsent log, returning the staged logs.
+  std::set<std::string> DrainUnsentLogs() {
+    std::set<std::string> logs;
+    while (log_store_->has_unsent_logs()) {
+      log_store_->StageNextLog();
+      logs.insert(log_store_->staged_log());
+      log_store_->DiscardStagedLog();
+    }
+    return logs;
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestingPrefServiceSimple local_state_;
+  PrefChangeRegistrar registrar_;
+  TestDelegate delegate_;
+  std::unique_ptr<BraveP3ALogStore> log_store_;
+  int pref_writes_ = 0;
+};
+
+TEST_F(BraveP3ALogStoreTest, CommitsBurstOfUpdatesOnce) {
+  log_store_->UpdateValue("Brave.P3A.A", 1);
+  log_store_->UpdateValue("Brave.P3A.B", 2);
+  log_store_->UpdateValue("Brave.P3A.A", 3);
+  log_store_->StageNextLog();
+  log_store_->DiscardStagedLog();
+  EXPECT_EQ(0, pref_writes_);
+
+  task_environment_.FastForwardBy(kCommitDelay);
+  EXPECT_EQ(1, pref_writes_);
+  const base::Value* logs = local_state_.GetDictionary(kPrefName);
+  EXPECT_EQ("3", *logs->FindStringPath("Brave.P3A.A.value"));
+  EXPECT_EQ("2", *logs->FindStringPath("Brave.P3A.B.value"));
+
+  // Nothing changed since, so there's nothing more to write.
+  task_environment_.FastForwardBy(kCommitDelay);
+  EXPECT_EQ(1, pref_writes_);
+}
+
+TEST_F(BraveP3ALogStoreTest, PersistUnsentLogsFlushesPendingEntries) {
+  log_store_->UpdateValue("Brave.P3A.A", 1);
+  log_store_->UpdateValue("Brave.P3A.B", 2);
+  log_store_->PersistUnsentLogs();
+  EXPECT_EQ(1, pref_writes_);
+  EXPECT_EQ("1", *local_state_.GetDictionary(kPrefName)
+                      ->FindStringPath("Brave.P3A.A.value"));
+
+  // The scheduled commit has nothing left to do.
+  task_environment_.FastForwardBy(kCommitDelay);
+  EXPECT_EQ(1, pref_writes_);
+}
+
+TEST_F(BraveP3ALogStoreTest, RestoresPersistedState) {
+  log_store_->UpdateValue("Brave.P3A.A", 1);
+  log_store_->UpdateValue("Brave.P3A.B", 2);
+  log_store_->UpdateValue("Brave.P3A.C", 3);
+  log_store_->StageNextLog();
+  const std::string sent_log = log_store_->staged_log();
+  log_store_->DiscardStagedLog();
+
+  std::set<std::string> unsent_logs = {"Brave.P3A.A=1", "Brave.P3A.B=2",
+                                       "Brave.P3A.C=3"};
+  ASSERT_EQ(1u, unsent_logs.erase(sent_log));
+
+  // Pending entries are written on destruction, before the commit delay.
+  log_store_.reset();
+  log_store_ = std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+  log_store_->LoadPersistedUnsentLogs();
+  EXPECT_EQ(unsent_logs, DrainUnsentLogs());
+
+  // The sent entry comes back once upload stamps are reset.
+  log_store_->ResetUploadStamps();
+  EXPECT_EQ(3u, DrainUnsentLogs().size());
+}
+
+}  // namespace brave
@@ -311,20 +311,36 @@ void BraveP3AService::OnHistogramChanged(base::StringPiece histogram_name,
     return;
   }
 
+  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
+          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
+
+  {
+    base::AutoLock lock(pending_histogram_values_lock_);
+    const bool task_pending = !pending_histogram_values_.empty();
+    pending_histogram_values_[histogram_name] = bucket;
+    if (task_pending) {
+      return;
+    }
+  }
+
   base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
+                 base::BindOnce(&BraveP3AService::OnHistogramsChangedOnUI,
+                                this));
 }
 
-void BraveP3AService::OnHistogramChangedOnUI(base::StringPiece histogram_name,
-                                             base::HistogramBase::Sample sample,
-                                             size_t bucket) {
-  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
-          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
-  if (!initialized_) {
-    histogram_values_[histogram_name] = bucket;
-  } else {
-    log_store_->UpdateValue(histogram_name.as_string(), bucket);
+void BraveP3AService::OnHistogramsChangedOnUI() {
+  base::flat_map<base::StringPiece, size_t> values;
+  {
+    base::AutoLock lock(pending_histogram_values_lock_);
+    values.swap(pending_histogram_values_);
+  }
+
+  for (const auto& entry : values) {
+    if (!initialized_) {
+      histogram_values_[entry.first] = entry.second;
+    } else {
+      log_store_->UpdateValue(entry.first.as_string(), entry.second);
+    }
   }
 }
 
@@ -12,6 +12,7 @@
 #include "base/containers/flat_map.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
+#include "base/synchronization/lock.h"
 #include "base/timer/timer.h"
 #include "brave/components/brave_prochlo/brave_prochlo_message.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
@@ -64,13 +65,13 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void StartScheduledUpload();
 
   // Invoked by callbacks registered by our service. Since these callbacks
-  // can fire on any thread, this method reposts everything to UI thread.
+  // can fire on any thread, this method queues the new bucket and reposts
+  // to UI thread. Only one task is in flight at a time, samples that come
+  // in meanwhile are picked up by it.
   void OnHistogramChanged(base::StringPiece histogram_name,
                           base::HistogramBase::Sample sample);
 
-  void OnHistogramChangedOnUI(base::StringPiece histogram_name,
-                              base::HistogramBase::Sample sample,
-                              size_t bucket);
+  void OnHistogramsChangedOnUI();
 
   void OnLogUploadComplete(int response_code, int error_code, bool was_https);
 
@@ -101,6 +102,10 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // the service and its initialization.
   base::flat_map<base::StringPiece, size_t> histogram_values_;
 
+  // Buckets reported from any thread that are not yet handled on UI thread.
+  base::Lock pending_histogram_values_lock_;
+  base::flat_map<base::StringPiece, size_t> pending_histogram_values_;
+
   // Once fired we restart the overall uploading process.
   base::OneShotTimer rotation_timer_;
 
@@ -0,0 +1,46 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_distill_state.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "brave/components/speedreader/rust/ffi/speedreader.h"
+
+namespace speedreader {
+
+namespace {
+
+// TODO(brave-browser/issues/10372): would be better to pass explicit signal
+// back from rewriter to indicate if content was found
+constexpr size_t kMinDistilledSize = 500;
+
+}  // namespace
+
+DistillState::DistillState(std::unique_ptr<Rewriter> rewriter)
+    : rewriter_(std::move(rewriter)) {
+  DCHECK(rewriter_);
+}
+
+DistillState::~DistillState() = default;
+
+bool DistillState::Write(const std::string& chunk) {
+  if (!write_failed_ && rewriter_->Write(chunk.data(), chunk.length()) != 0)
+    write_failed_ = true;
+  return !write_failed_;
+}
+
+std::string DistillState::Finish() {
+  if (write_failed_ || rewriter_->End() != 0)
+    return std::string();
+
+  const std::string& transformed = rewriter_->GetOutput();
+  if (transformed.length() < kMinDistilledSize)
+    return std::string();
+  return transformed;
+}
+
+}  // namespace speedreader
@@ -0,0 +1,43 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILL_STATE_H_
+#define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILL_STATE_H_
+
+#include <memory>
+#include <string>
+
+namespace speedreader {
+
+class Rewriter;
+
+// Distills one response body with a rewriter that is fed chunk by chunk.
+// Once a write fails the rewriter output is incomplete, so the failure is
+// remembered and the page is never served distilled. Used on a single
+// sequence.
+class DistillState {
+ public:
+  explicit DistillState(std::unique_ptr<Rewriter> rewriter);
+  ~DistillState();
+
+  DistillState(const DistillState&) = delete;
+  DistillState& operator=(const DistillState&) = delete;
+
+  // Feeds the next chunk of the body. Returns false if this or any earlier
+  // write failed.
+  bool Write(const std::string& chunk);
+
+  // Ends the rewriter and returns its output, or an empty string if the page
+  // should be shown as is.
+  std::string Finish();
+
+ private:
+  std::unique_ptr<Rewriter> rewriter_;
+  bool write_failed_ = false;
+};
+
+}  // namespace speedreader
+
+#endif  // BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILL_STATE_H_
@@ -0,0 +1,87 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_distill_state.h"
+
+#include <cstring>
+#include <string>
+
+#include "brave/components/speedreader/rust/ffi/speedreader.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace speedreader {
+
+namespace {
+
+constexpr char kTestConfig[] = R"(
+[
+    {
+        "domain": "example.com",
+        "url_rules": [
+            "||example.com/*/article/"
+        ],
+        "declarative_rewrite": {
+            "main_content": [
+                ".article-title",
+                ".article-body"
+            ],
+            "main_content_cleanup": [
+                ".hidden"
+            ],
+            "delazify": true,
+            "fix_embeds": false,
+            "content_script": null,
+            "preprocess": []
+        }
+    }
+]
+)";
+
+constexpr char kArticleUrl[] =
+    "https://example.com/news/article/topic/index.html";
+
+// Long enough for the output to be served as a distilled page.
+std::string ArticleStart() {
+  return "<html><div class=\"article-body\">" + std::string(600, 'a') +
+         "</div>";
+}
+
+class SpeedreaderDistillStateTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(speedreader_.deserialize(kTestConfig, strlen(kTestConfig)));
+  }
+
+  SpeedReader speedreader_;
+};
+
+}  // namespace
+
+TEST_F(SpeedreaderDistillStateTest, Distills) {
+  DistillState state(speedreader_.MakeRewriter(kArticleUrl));
+  ASSERT_TRUE(state.Write(ArticleStart()));
+  ASSERT_TRUE(state.Write("</html>"));
+  EXPECT_EQ(ArticleStart() + "</html>", state.Finish());
+}
+
+TEST_F(SpeedreaderDistillStateTest, ShortOutputIsNotServed) {
+  DistillState state(speedreader_.MakeRewriter(kArticleUrl));
+  ASSERT_TRUE(
+      state.Write("<html><div class=\"article-body\">hi</div></html>"));
+  EXPECT_TRUE(state.Finish().empty());
+}
+
+// The last chunk makes the rewriter fail after a long article was already
+// written. The partial output must not be served.
+TEST_F(SpeedreaderDistillStateTest, FailureOnLastChunkIsNotServed) {
+  DistillState state(speedreader_.MakeRewriter(kArticleUrl));
+  ASSERT_TRUE(state.Write(ArticleStart()));
+  // The rewriter reports the parsing ambiguity either on write or on end.
+  if (!state.Write("<select><div><style><div></div></style></div></select>"))
+    EXPECT_FALSE(state.Write("</html>"));
+  EXPECT_TRUE(state.Finish().empty());
+}
+
+}  // namespace speedreader
@@ -12,7 +12,9 @@
 #include "base/bind.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
+#include "base/task_runner_util.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
+#include "brave/components/speedreader/speedreader_distill_state.h"
 #include "brave/components/speedreader/speedreader_throttle.h"
 #include "brave/components/speedreader/speedreader_whitelist.h"
 #include "components/grit/brave_components_resources.h"
@@ -26,6 +28,10 @@ namespace {
 
 constexpr uint32_t kReadBufferSize = 32768;
 
+// Pages larger than this are unlikely to be articles; rather than holding the
+// whole response back we give up distilling and stream it through.
+constexpr size_t kMaxBufferedBodySize = 10 * 1024 * 1024;
+
 std::string GetDistilledPageResources() {
   return "<style id=\"brave_speedreader_style\">" +
          ui::ResourceBundle::GetSharedInstance()
@@ -34,6 +40,21 @@ std::string GetDistilledPageResources() {
          "</style>";
 }
 
+bool WriteToDistiller(DistillState* distill_state, std::string chunk) {
+  return distill_state->Write(chunk);
+}
+
+// Returns the distilled page or an empty string if the page should be shown
+// as is, which includes any earlier write having failed.
+std::string FinishDistilling(DistillState* distill_state) {
+  SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
+  const std::string transformed = distill_state->Finish();
+  if (transformed.empty())
+    return std::string();
+
+  return GetDistilledPageResources() + transformed;
+}
+
 }  // namespace
 
 // static
@@ -78,6 +99,10 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
       body_producer_watcher_(FROM_HERE,
                              mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                              std::move(task_runner)),
+      distill_task_runner_(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::TaskPriority::USER_BLOCKING})),
+      distill_state_(nullptr,
+                     base::OnTaskRunnerDeleter(distill_task_runner_)),
       whitelist_(whitelist) {}
 
 SpeedReaderURLLoader::~SpeedReaderURLLoader() = default;
@@ -128,6 +153,12 @@ void SpeedReaderURLLoader::OnStartLoadingResponseBody(
     mojo::ScopedDataPipeConsumerHandle body) {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kLoading;
+  if (whitelist_) {
+    std::unique_ptr<Rewriter> rewriter =
+        whitelist_->MakeRewriter(response_url_);
+    if (rewriter)
+      distill_state_.reset(new DistillState(std::move(rewriter)));
+  }
   body_consumer_handle_ = std::move(body);
   body_consumer_watcher_.Watch(
       body_consumer_handle_.get(),
@@ -197,7 +228,14 @@ void SpeedReaderURLLoader::ResumeReadingBodyFromNet() {
 }
 
 void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
-  DCHECK_EQ(State::kLoading, state_);
+  DCHECK(state_ == State::kLoading || state_ == State::kSending);
+  if (state_ == State::kSending) {
+    // Passing the body through; read more only once the buffer is drained.
+    // OnBodyWritable() re-arms the watcher after that.
+    if (bytes_remaining_in_buffer_ > 0)
+      return;
+    buffered_body_.clear();
+  }
 
   size_t start_size = buffered_body_.size();
   uint32_t read_bytes = kReadBufferSize;
@@ -210,9 +248,14 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
     case MOJO_RESULT_FAILED_PRECONDITION:
       // Reading is finished.
       buffered_body_.resize(start_size);
-      MaybeLaunchSpeedreader();
+      body_finished_ = true;
+      if (state_ == State::kLoading)
+        MaybeLaunchSpeedreader();
+      else
+        CompleteSending();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
+      buffered_body_.resize(start_size);
       body_consumer_watcher_.ArmOrNotify();
       return;
     default:
@@ -222,11 +265,19 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
 
   DCHECK_EQ(MOJO_RESULT_OK, result);
   buffered_body_.resize(start_size + read_bytes);
-  // TODO(iefremov): We actually can partially |pumpContent| to speedreader,
-  // but skipping it for now to simplify things. Pumping is not free in terms
-  // of CPU ticks, so we will have to keep alive speedreader instance on another
-  // thread.
 
+  if (state_ == State::kSending) {
+    bytes_remaining_in_buffer_ = buffered_body_.size();
+    SendReceivedBodyToClient();
+    return;
+  }
+
+  if (!distill_state_ || buffered_body_.size() > kMaxBufferedBodySize) {
+    StartPassthrough();
+    return;
+  }
+
+  PumpToRewriter(start_size, read_bytes);
   body_consumer_watcher_.ArmOrNotify();
 }
 
@@ -234,11 +285,33 @@ void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
   DCHECK_EQ(State::kSending, state_);
   if (bytes_remaining_in_buffer_ > 0) {
     SendReceivedBodyToClient();
-  } else {
+  } else if (body_finished_) {
     CompleteSending();
+  } else {
+    body_consumer_watcher_.ArmOrNotify();
   }
 }
 
+void SpeedReaderURLLoader::PumpToRewriter(size_t offset, size_t length) {
+  DCHECK(distill_state_);
+  // |distill_state_| is deleted on |distill_task_runner_| after all the tasks
+  // posted here, so it is safe to pass it unretained.
+  base::PostTaskAndReplyWithResult(
+      distill_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&WriteToDistiller, base::Unretained(distill_state_.get()),
+                     buffered_body_.substr(offset, length)),
+      base::BindOnce(&SpeedReaderURLLoader::OnRewriterWrite,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void SpeedReaderURLLoader::OnRewriterWrite(bool success) {
+  // Error occurred; there is no point in holding the body back any longer.
+  // If the whole body has been read already, the failure is remembered by
+  // |distill_state_| and FinishDistilling() falls back to the original body.
+  if (!success && state_ == State::kLoading && !body_finished_)
+    StartPassthrough();
+}
+
 void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
   DCHECK_EQ(State::kLoading, state_);
   if (!throttle_ || !whitelist_) {
@@ -247,38 +320,39 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
   }
 
   VLOG(2) << __func__ << " buffered body size = " << buffered_body_.size();
-  bytes_remaining_in_buffer_ = buffered_body_.size();
 
-  if (bytes_remaining_in_buffer_ > 0) {
-    // Offload heavy distilling to another thread.
+  if (distill_state_ && !buffered_body_.empty()) {
+    // Everything has already been pumped to the rewriter, only the final
+    // (heavy) pass is left.
     base::PostTaskAndReplyWithResult(
-        FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
-        base::BindOnce(
-            [](std::string data, std::unique_ptr<Rewriter> rewriter) -> auto {
-              SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
-              int written = rewriter->Write(data.c_str(), data.length());
-              // Error occurred
-              if (written != 0) {
-                return data;
-              }
-
-              rewriter->End();
-              const std::string& transformed = rewriter->GetOutput();
-
-              // TODO(brave-browser/issues/10372): would be better to pass
-              // explicit signal back from rewriter to indicate if content was
-              // found
-              if (transformed.length() < 500) {
-                return data;
-              }
-
-              return GetDistilledPageResources() + transformed;
-            },
-            std::move(buffered_body_), whitelist_->MakeRewriter(response_url_)),
-        base::BindOnce(&SpeedReaderURLLoader::CompleteLoading,
+        distill_task_runner_.get(), FROM_HERE,
+        base::BindOnce(&FinishDistilling,
+                       base::Unretained(distill_state_.get())),
+        base::BindOnce(&SpeedReaderURLLoader::OnDistilled,
                        weak_factory_.GetWeakPtr()));
     return;
   }
+  distill_state_.reset();
+  CompleteLoading(std::move(buffered_body_));
+}
+
+void SpeedReaderURLLoader::OnDistilled(std::string distilled) {
+  // Distilling might have been given up in the meantime.
+  if (state_ != State::kLoading)
+    return;
+  distill_state_.reset();
+  if (distilled.empty()) {
+    CompleteLoading(std::move(buffered_body_));
+    return;
+  }
+  buffered_body_.clear();
+  CompleteLoading(std::move(distilled));
+}
+
+void SpeedReaderURLLoader::StartPassthrough() {
+  DCHECK_EQ(State::kLoading, state_);
+  VLOG(2) << __func__ << " " << response_url_;
+  distill_state_.reset();
   CompleteLoading(std::move(buffered_body_));
 }
 
@@ -313,13 +387,16 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   destination_url_loader_client_->OnStartLoadingResponseBody(
       std::move(body_to_send));
 
-  DCHECK(bytes_remaining_in_buffer_);
   if (bytes_remaining_in_buffer_) {
     SendReceivedBodyToClient();
     return;
   }
 
-  CompleteSending();
+  if (body_finished_) {
+    CompleteSending();
+    return;
+  }
+  body_consumer_watcher_.ArmOrNotify();
 }
 
 void SpeedReaderURLLoader::CompleteSending() {
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -13,6 +14,7 @@
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/string_piece.h"
 #include "mojo/public/cpp/bindings/binding.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
@@ -27,6 +29,7 @@
 
 namespace speedreader {
 
+class DistillState;
 class SpeedReaderThrottle;
 class SpeedreaderWhitelist;
 
@@ -39,12 +42,16 @@ class SpeedreaderWhitelist;
 //               finished (= OnComplete() is called). When body is provided, the
 //               state is changed to kLoading. Otherwise the state goes to
 //               kCompleted.
-// kLoading: Receives the body from the source loader and distills the page.
-//            The received body is kept in this loader until distilling
-//            is finished. When all body has been received and distilling is
+// kLoading: Receives the body from the source loader and pumps every chunk
+//            into the rewriter on a background sequence as it arrives. The
+//            received body is kept in this loader until distilling is
+//            finished. When all body has been received and distilling is
 //            done, this loader will dispatch queued messages like
 //            OnStartLoadingResponseBody() to the destination
 //            loader client, and then the state is changed to kSending.
+//            If the rewriter fails or the body grows beyond
+//            |kMaxBufferedBodySize| distilling is given up and the body is
+//            passed through untouched right away.
 // kSending: Receives the body and sends it to the destination loader client.
 //           The state changes to kCompleted after all data is sent.
 // kCompleted: All data has been sent to the destination loader.
@@ -111,7 +118,15 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
 
   void OnBodyReadable(MojoResult);
   void OnBodyWritable(MojoResult);
+  // Feeds |length| bytes of |buffered_body_| starting at |offset| to the
+  // rewriter on |distill_task_runner_|.
+  void PumpToRewriter(size_t offset, size_t length);
+  void OnRewriterWrite(bool success);
   void MaybeLaunchSpeedreader();
+  void OnDistilled(std::string distilled);
+  // Stops distilling and sends the body received so far (and the rest of it
+  // afterwards) untouched.
+  void StartPassthrough();
 
   // Gets either distilled or untouched body.
   void CompleteLoading(std::string body);
@@ -139,13 +154,20 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
 
   // Note that this could be replaced by a distilled version.
   std::string buffered_body_;
-  size_t bytes_remaining_in_buffer_;
+  size_t bytes_remaining_in_buffer_ = 0;
+  // Set once the source body pipe has been fully read.
+  bool body_finished_ = false;
 
   mojo::ScopedDataPipeConsumerHandle body_consumer_handle_;
   mojo::ScopedDataPipeProducerHandle body_producer_handle_;
   mojo::SimpleWatcher body_consumer_watcher_;
   mojo::SimpleWatcher body_producer_watcher_;
 
+  // The rewriter lives on |distill_task_runner_| and is fed while the body is
+  // still being downloaded. Reset once distilling is given up.
+  scoped_refptr<base::SequencedTaskRunner> distill_task_runner_;
+  std::unique_ptr<DistillState, base::OnTaskRunnerDeleter> distill_state_;
+
   // Not Owned
   SpeedreaderWhitelist* whitelist_;
 
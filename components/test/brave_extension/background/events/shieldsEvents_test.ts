@@ -15,13 +15,19 @@ describe('shieldsEvents events', () => {
     afterEach(() => {
       spy.mockRestore()
     })
-    it('forward details to actions.resourceBlocked', (cb) => {
+    it('forward each of the details to actions.resourceBlocked', (cb) => {
+      const otherBlockedResource = {
+        ...blockedResource,
+        subresource: 'https://www.brave.com/other.js'
+      }
       chrome.braveShields.onBlocked.addListener((details) => {
-        expect(details).toBe(blockedResource)
-        expect(spy).toBeCalledWith(details)
+        expect(details).toEqual([blockedResource, otherBlockedResource])
+        expect(spy).toHaveBeenCalledTimes(2)
+        expect(spy).toBeCalledWith(blockedResource)
+        expect(spy).toBeCalledWith(otherBlockedResource)
         cb()
       })
-      chrome.braveShields.onBlocked.emit(blockedResource)
+      chrome.braveShields.onBlocked.emit([blockedResource, otherBlockedResource])
     })
   })
 })
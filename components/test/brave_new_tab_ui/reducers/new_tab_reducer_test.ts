@@ -23,7 +23,32 @@ describe('newTabReducer', () => {
     // TODO
   })
   describe('NEW_TAB_STATS_UPDATED', () => {
-    // TODO
+    it('merges changed stats into the existing stats', () => {
+      const assertion = newTabReducer({
+        ...storage.defaultState,
+        stats: {
+          ...storage.defaultState.stats,
+          adsBlockedStat: 1,
+          javascriptBlockedStat: 2
+        }
+      }, {
+        type: types.NEW_TAB_STATS_UPDATED,
+        payload: {
+          stats: {
+            adsBlockedStat: 10
+          }
+        }
+      })
+      const expectedState = {
+        ...storage.defaultState,
+        stats: {
+          ...storage.defaultState.stats,
+          adsBlockedStat: 10,
+          javascriptBlockedStat: 2
+        }
+      }
+      expect(assertion).toEqual(expectedState)
+    })
   })
   describe('NEW_TAB_PRIVATE_TAB_DATA_UPDATED', () => {
     // TODO
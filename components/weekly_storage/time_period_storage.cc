@@ -0,0 +1,201 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/time_period_storage.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/time/clock.h"
+#include "base/time/default_clock.h"
+#include "base/values.h"
+#include "components/prefs/pref_service.h"
+#include "components/prefs/scoped_user_pref_update.h"
+
+namespace {
+// Values are usually added in bursts, so prefs are written at most this often.
+constexpr base::TimeDelta kSaveDelay = base::TimeDelta::FromSeconds(10);
+}  // namespace
+
+TimePeriodStorage::TimePeriodStorage(PrefService* prefs,
+                                     const char* pref_name,
+                                     size_t period_days)
+    : TimePeriodStorage(prefs,
+                        pref_name,
+                        period_days,
+                        std::make_unique<base::DefaultClock>()) {}
+
+TimePeriodStorage::TimePeriodStorage(PrefService* prefs,
+                                     const char* pref_name,
+                                     size_t period_days,
+                                     std::unique_ptr<base::Clock> clock)
+    : prefs_(prefs),
+      pref_name_(pref_name),
+      period_days_(period_days),
+      clock_(std::move(clock)),
+      daily_values_(period_days) {
+  DCHECK(pref_name);
+  DCHECK_GT(period_days, 0u);
+  if (prefs) {
+    Load();
+  }
+}
+
+TimePeriodStorage::~TimePeriodStorage() {
+  FlushPendingChanges();
+}
+
+void TimePeriodStorage::AddDelta(uint64_t delta) {
+  base::Time now_midnight = clock_->Now().LocalMidnight();
+  base::Time last_saved_midnight;
+
+  if (size_ > 0) {
+    last_saved_midnight = daily_values_[head_].day;
+  }
+
+  if (now_midnight - last_saved_midnight > base::TimeDelta()) {
+    // Day changed. Since we consider only small incoming intervals, lets just
+    // save it with a new timestamp.
+    head_ = (head_ + 1) % period_days_;
+    const bool overwrites_highest = size_ == period_days_ && highest_ == head_;
+    if (size_ == period_days_) {
+      // Overwriting the oldest day.
+      total_ -= daily_values_[head_].value;
+    } else {
+      size_++;
+    }
+    daily_values_[head_] = {now_midnight, delta};
+    // Rescanning happens at most once a day.
+    if (overwrites_highest) {
+      UpdateHighest();
+    } else if (size_ == 1 || delta >= daily_values_[highest_].value) {
+      highest_ = head_;
+    }
+  } else {
+    daily_values_[head_].value += delta;
+    if (daily_values_[head_].value >= daily_values_[highest_].value)
+      highest_ = head_;
+  }
+  total_ += delta;
+
+  ScheduleSave();
+}
+
+uint64_t TimePeriodStorage::GetPeriodSum() const {
+  // We record only value for last N days.
+  const base::Time n_days_ago =
+      clock_->Now() - base::TimeDelta::FromDays(period_days_);
+  uint64_t sum = total_;
+  // Days are ordered, so only the oldest ones may be out of the period.
+  for (size_t i = size_; i > 0; i--) {
+    const DailyValue& daily_value = GetDailyValue(i - 1);
+    if (daily_value.day > n_days_ago) {
+      break;
+    }
+    sum -= daily_value.value;
+  }
+  return sum;
+}
+
+uint64_t TimePeriodStorage::GetHighestValueInPeriod() const {
+  if (size_ == 0) {
+    return 0ull;
+  }
+  const base::Time n_days_ago =
+      clock_->Now() - base::TimeDelta::FromDays(period_days_);
+  if (daily_values_[highest_].day > n_days_ago) {
+    return daily_values_[highest_].value;
+  }
+  // The highest day is out of the period, which only happens after no values
+  // were added for a while, so scan the days that are left.
+  uint64_t highest = 0ull;
+  for (size_t i = 0; i < size_; i++) {
+    const DailyValue& daily_value = GetDailyValue(i);
+    if (daily_value.day <= n_days_ago) {
+      break;
+    }
+    highest = std::max(highest, daily_value.value);
+  }
+  return highest;
+}
+
+bool TimePeriodStorage::IsOnePeriodPassed() const {
+  // TODO(iefremov): This is not true 100% (if the browser was launched once
+  // per week just after installation, for example).
+  return size_ == period_days_;
+}
+
+void TimePeriodStorage::FlushPendingChanges() {
+  if (!save_timer_.IsRunning()) {
+    return;
+  }
+  save_timer_.Stop();
+  Save();
+}
+
+const TimePeriodStorage::DailyValue& TimePeriodStorage::GetDailyValue(
+    size_t index) const {
+  DCHECK_LT(index, size_);
+  return daily_values_[(head_ + period_days_ - index) % period_days_];
+}
+
+void TimePeriodStorage::UpdateHighest() {
+  highest_ = head_;
+  for (size_t i = 1; i < size_; i++) {
+    const size_t slot = (head_ + period_days_ - i) % period_days_;
+    if (daily_values_[slot].value > daily_values_[highest_].value) {
+      highest_ = slot;
+    }
+  }
+}
+
+void TimePeriodStorage::Load() {
+  DCHECK_EQ(size_, 0u);
+  const base::ListValue* list = prefs_->GetList(pref_name_);
+  if (!list) {
+    return;
+  }
+  // Persisted days go from the latest to the oldest one.
+  for (auto it = list->begin(); it != list->end(); ++it) {
+    const base::Value* day = it->FindKey("day");
+    const base::Value* value = it->FindKey("value");
+    if (!day || !value || !day->is_double() || !value->is_double()) {
+      continue;
+    }
+    if (size_ == period_days_) {
+      break;
+    }
+    DailyValue& daily_value =
+        daily_values_[(head_ + period_days_ - size_) % period_days_];
+    daily_value.day = base::Time::FromDoubleT(day->GetDouble());
+    daily_value.value = static_cast<uint64_t>(value->GetDouble());
+    total_ += daily_value.value;
+    size_++;
+  }
+  UpdateHighest();
+}
+
+void TimePeriodStorage::ScheduleSave() {
+  if (!prefs_ || save_timer_.IsRunning()) {
+    return;
+  }
+  save_timer_.Start(FROM_HERE, kSaveDelay, this, &TimePeriodStorage::Save);
+}
+
+void TimePeriodStorage::Save() {
+  DCHECK_GT(size_, 0u);
+  DCHECK_LE(size_, period_days_);
+
+  ListPrefUpdate update(prefs_, pref_name_);
+  base::ListValue* list = update.Get();
+  list->Clear();
+  for (size_t i = 0; i < size_; i++) {
+    const DailyValue& daily_value = GetDailyValue(i);
+    base::DictionaryValue value;
+    value.SetKey("day", base::Value(daily_value.day.ToDoubleT()));
+    value.SetDoubleKey("value", daily_value.value);
+    list->Append(std::move(value));
+  }
+}
@@ -0,0 +1,85 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_TIME_PERIOD_STORAGE_H_
+#define BRAVE_COMPONENTS_WEEKLY_STORAGE_TIME_PERIOD_STORAGE_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace base {
+class Clock;
+}
+
+class PrefService;
+
+// Tracks per-day sums of values added via |AddDelta| over the last
+// |period_days| days. Days are kept in a fixed-size ring buffer, so updates
+// are O(1) and the running total and the highest day are maintained
+// incrementally. Meant to be long-lived: keep one instance per pref.
+// Changes are written to |pref_name| (must be a registered list pref) in a
+// single batch shortly after the first change, on |FlushPendingChanges| or on
+// destruction.
+class TimePeriodStorage {
+ public:
+  TimePeriodStorage(PrefService* prefs,
+                    const char* pref_name,
+                    size_t period_days);
+
+  // For tests.
+  TimePeriodStorage(PrefService* prefs,
+                    const char* pref_name,
+                    size_t period_days,
+                    std::unique_ptr<base::Clock> clock);
+  virtual ~TimePeriodStorage();
+
+  TimePeriodStorage(const TimePeriodStorage&) = delete;
+  TimePeriodStorage& operator=(const TimePeriodStorage&) = delete;
+
+  void AddDelta(uint64_t delta);
+  uint64_t GetPeriodSum() const;
+  uint64_t GetHighestValueInPeriod() const;
+  bool IsOnePeriodPassed() const;
+
+  // Writes pending changes to prefs right away.
+  void FlushPendingChanges();
+
+ private:
+  struct DailyValue {
+    base::Time day;
+    uint64_t value = 0ull;
+  };
+
+  // Returns the |index|-th most recent day, 0 being the latest one.
+  const DailyValue& GetDailyValue(size_t index) const;
+  // Points |highest_| at the highest of the stored days.
+  void UpdateHighest();
+
+  void Load();
+  void ScheduleSave();
+  void Save();
+
+  PrefService* prefs_ = nullptr;
+  const char* pref_name_ = nullptr;
+  const size_t period_days_;
+  std::unique_ptr<base::Clock> clock_;
+
+  // Ring buffer of |period_days_| slots; |head_| points at the latest day.
+  std::vector<DailyValue> daily_values_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+  // Sum of all the stored days, including those that are already out of
+  // the period but not yet overwritten.
+  uint64_t total_ = 0ull;
+  // Slot of the highest stored day.
+  size_t highest_ = 0;
+
+  base::OneShotTimer save_timer_;
+};
+
+#endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_TIME_PERIOD_STORAGE_H_
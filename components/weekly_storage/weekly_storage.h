@@ -6,23 +6,14 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 
-#include <list>
 #include <memory>
 
-#include "base/time/time.h"
-
-namespace base {
-class Clock;
-}
-
-class PrefService;
+#include "brave/components/weekly_storage/time_period_storage.h"
 
 // Mostly used by various P3A recorders - allows to track a sum of some
 // values added from time to time via |AddDelta| over a last week.
 // Requires |pref_name| to be already registered.
-// Feel free to improve and refactor it - templatize a stored value type,
-// change weekly interval or make a keyed service from it.
-class WeeklyStorage {
+class WeeklyStorage : public TimePeriodStorage {
  public:
   WeeklyStorage(PrefService* prefs, const char* pref_name);
 
@@ -30,28 +21,13 @@ class WeeklyStorage {
   WeeklyStorage(PrefService* user_prefs,
                 const char* pref_name,
                 std::unique_ptr<base::Clock> clock);
-  ~WeeklyStorage();
+  ~WeeklyStorage() override;
 
   WeeklyStorage(const WeeklyStorage&) = delete;
   WeeklyStorage& operator=(const WeeklyStorage&) = delete;
 
-  void AddDelta(uint64_t delta);
   uint64_t GetWeeklySum() const;
   bool IsOneWeekPassed() const;
-
- private:
-  struct DailyValue {
-    base::Time day;
-    uint64_t value = 0ull;
-  };
-  void Load();
-  void Save();
-
-  PrefService* prefs_ = nullptr;
-  const char* pref_name_ = nullptr;
-  std::unique_ptr<base::Clock> clock_;
-
-  std::list<DailyValue> daily_values_;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
@@ -5,19 +5,82 @@
 
 #include "brave/components/weekly_storage/weekly_storage.h"
 
+#include <algorithm>
+#include <list>
 #include <memory>
+#include <numeric>
 #include <utility>
 
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+
+constexpr char kPrefName[] = "brave.weekly_test";
+
+// The list-based implementation WeeklyStorage used to have, kept to check
+// that the ring buffer gives the same answers.
+class ListWeeklyStorage {
+ public:
+  explicit ListWeeklyStorage(base::Clock* clock) : clock_(clock) {}
+
+  void AddDelta(uint64_t delta) {
+    base::Time now_midnight = clock_->Now().LocalMidnight();
+    base::Time last_saved_midnight;
+    if (!daily_values_.empty()) {
+      last_saved_midnight = daily_values_.front().day;
+    }
+    if (now_midnight - last_saved_midnight > base::TimeDelta()) {
+      daily_values_.push_front({now_midnight, delta});
+      if (daily_values_.size() > 7) {
+        daily_values_.pop_back();
+      }
+    } else {
+      daily_values_.front().value += delta;
+    }
+  }
+
+  uint64_t GetWeeklySum() const {
+    const base::Time n_days_ago =
+        clock_->Now() - base::TimeDelta::FromDays(7);
+    return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
+                           [n_days_ago](const uint64_t acc, const auto& u2) {
+                             return acc + (u2.day > n_days_ago ? u2.value : 0);
+                           });
+  }
+
+  uint64_t GetHighestValueInWeek() const {
+    const base::Time n_days_ago =
+        clock_->Now() - base::TimeDelta::FromDays(7);
+    uint64_t highest = 0ull;
+    for (const auto& daily_value : daily_values_) {
+      if (daily_value.day > n_days_ago)
+        highest = std::max(highest, daily_value.value);
+    }
+    return highest;
+  }
+
+  bool IsOneWeekPassed() const { return daily_values_.size() == 7; }
+
+ private:
+  struct DailyValue {
+    base::Time day;
+    uint64_t value = 0ull;
+  };
+
+  base::Clock* clock_;
+  std::list<DailyValue> daily_values_;
+};
+
+}  // namespace
+
 class WeeklyStorageTest : public ::testing::Test {
  public:
   WeeklyStorageTest() : clock_(new base::SimpleTestClock) {
-    constexpr char kPrefName[] = "brave.weekly_test";
     pref_service_.registry()->RegisterListPref(kPrefName);
 
     state_ = std::make_unique<WeeklyStorage>(
@@ -26,6 +89,7 @@ class WeeklyStorageTest : public ::testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_;
   base::SimpleTestClock* clock_;
   TestingPrefServiceSimple pref_service_;
   std::unique_ptr<WeeklyStorage> state_;
@@ -96,3 +160,50 @@ TEST_F(WeeklyStorageTest, InfrequentUsage) {
   state_->AddDelta(saving);
   EXPECT_EQ(state_->GetWeeklySum(), 2 * saving);
 }
+
+TEST_F(WeeklyStorageTest, MatchesListImplementation) {
+  ListWeeklyStorage expected(clock_);
+  for (int i = 0; i < 200; i++) {
+    // Irregular steps: several updates a day, skipped days, long breaks.
+    clock_->Advance(base::TimeDelta::FromHours((i * 7) % 61));
+    const uint64_t delta = (i * 37) % 1000;
+    state_->AddDelta(delta);
+    expected.AddDelta(delta);
+    EXPECT_EQ(state_->GetWeeklySum(), expected.GetWeeklySum());
+    EXPECT_EQ(state_->GetHighestValueInPeriod(),
+              expected.GetHighestValueInWeek());
+    EXPECT_EQ(state_->IsOneWeekPassed(), expected.IsOneWeekPassed());
+  }
+}
+
+TEST_F(WeeklyStorageTest, HighestValueInWeek) {
+  state_->AddDelta(10);
+  clock_->Advance(base::TimeDelta::FromDays(1));
+  state_->AddDelta(30);
+  clock_->Advance(base::TimeDelta::FromDays(1));
+  state_->AddDelta(20);
+  EXPECT_EQ(state_->GetHighestValueInPeriod(), 30ULL);
+
+  clock_->Advance(base::TimeDelta::FromDays(7));
+  state_->AddDelta(5);
+  EXPECT_EQ(state_->GetHighestValueInPeriod(), 5ULL);
+}
+
+TEST_F(WeeklyStorageTest, DefersPersistence) {
+  state_->AddDelta(10);
+  state_->AddDelta(20);
+  EXPECT_TRUE(pref_service_.GetList(kPrefName)->GetList().empty());
+
+  state_->FlushPendingChanges();
+  EXPECT_EQ(pref_service_.GetList(kPrefName)->GetList().size(), 1UL);
+
+  state_->AddDelta(30);
+  const base::Time now = clock_->Now();
+  // Pending changes are saved on destruction.
+  state_.reset();
+
+  auto clock = std::make_unique<base::SimpleTestClock>();
+  clock->SetNow(now);
+  WeeklyStorage restored(&pref_service_, kPrefName, std::move(clock));
+  EXPECT_EQ(restored.GetWeeklySum(), 60ULL);
+}
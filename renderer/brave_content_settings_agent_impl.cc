@@ -5,17 +5,20 @@
 
 #include "brave/renderer/brave_content_settings_agent_impl.h"
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/bind_helpers.h"
 #include "base/feature_list.h"
+#include "base/no_destructor.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/render_messages.h"
 #include "brave/common/shield_exceptions.h"
 #include "brave/components/brave_shields/common/features.h"
+#include "brave/components/content_settings/core/common/content_settings_rules_index.h"
 #include "brave/content/common/frame_messages.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "components/content_settings/core/common/content_settings_utils.h"
@@ -47,42 +50,76 @@ GURL GetOriginOrURL(
   return top_origin.GetURL();
 }
 
-bool IsBraveShieldsDown(const blink::WebFrame* frame,
-                        const GURL& secondary_url,
-                        const ContentSettingsForOneType& rules) {
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
+// Lookup indexes for the rules last received by this renderer. All frames
+// see the same rules, so the indexes are shared and only rebuilt when new
+// rules arrive.
+struct RulesIndexes {
+  uint64_t revision = 0;
+  std::unique_ptr<content_settings::ContentSettingsRulesIndex> brave_shields;
+  std::unique_ptr<content_settings::ContentSettingsRulesIndex> fingerprinting;
+};
+
+const RulesIndexes* GetRulesIndexes(const RendererContentSettingRules* rules) {
+  // Rules that didn't come through IPC carry no revision to key on.
+  if (!rules || !rules->brave_rules_revision)
+    return nullptr;
+
+  static base::NoDestructor<RulesIndexes> indexes;
+  if (indexes->revision != rules->brave_rules_revision) {
+    indexes->revision = rules->brave_rules_revision;
+    indexes->brave_shields =
+        std::make_unique<content_settings::ContentSettingsRulesIndex>(
+            rules->brave_shields_rules);
+    indexes->fingerprinting =
+        std::make_unique<content_settings::ContentSettingsRulesIndex>(
+            rules->fingerprinting_rules);
+  }
+  return indexes.get();
+}
+
+ContentSetting GetContentSettingFromRules(
+    const ContentSettingsForOneType& rules,
+    const content_settings::ContentSettingsRulesIndex* index,
+    const GURL& primary_url,
+    const GURL& secondary_url) {
+  if (index) {
+    const ContentSettingPatternSource* rule =
+        index->FindFirstMatch(primary_url, secondary_url);
+    return rule ? rule->GetContentSetting() : CONTENT_SETTING_DEFAULT;
+  }
 
   for (const auto& rule : rules) {
     if (rule.primary_pattern.Matches(primary_url) &&
         rule.secondary_pattern.Matches(secondary_url)) {
-      setting = rule.GetContentSetting();
-      break;
+      return rule.GetContentSetting();
     }
   }
+  return CONTENT_SETTING_DEFAULT;
+}
 
-  return setting == CONTENT_SETTING_BLOCK;
+bool IsBraveShieldsDown(const blink::WebFrame* frame,
+                        const GURL& secondary_url,
+                        const RendererContentSettingRules& rules) {
+  const RulesIndexes* indexes = GetRulesIndexes(&rules);
+  return GetContentSettingFromRules(
+             rules.brave_shields_rules,
+             indexes ? indexes->brave_shields.get() : nullptr,
+             GetOriginOrURL(frame), secondary_url) == CONTENT_SETTING_BLOCK;
 }
 
-template <typename URL>
-ContentSetting GetBraveContentSettingFromRules(
-    const ContentSettingsForOneType& shield_rules,
-    const ContentSettingsForOneType& rules,
+ContentSetting GetBraveFingerprintingSettingFromRules(
+    const RendererContentSettingRules& rules,
     const blink::WebFrame* frame,
-    const URL& secondary_url) {
+    const GURL& secondary_url) {
   // if shields is down, allow everything
-  if (IsBraveShieldsDown(frame, secondary_url, shield_rules))
+  if (IsBraveShieldsDown(frame, secondary_url, rules))
     return CONTENT_SETTING_ALLOW;
 
-  const GURL& primary_url = GetOriginOrURL(frame);
-  const GURL& secondary_gurl = secondary_url;
-  for (const auto& rule : rules) {
-    if (rule.primary_pattern.Matches(primary_url) &&
-        rule.secondary_pattern.Matches(secondary_gurl)) {
-      return rule.GetContentSetting();
-    }
-  }
-  return CONTENT_SETTING_DEFAULT;
+  const RulesIndexes* indexes = GetRulesIndexes(&rules);
+  return GetContentSettingFromRules(
+      rules.fingerprinting_rules,
+      indexes ? indexes->fingerprinting.get() : nullptr, GetOriginOrURL(frame),
+      secondary_url);
 }
 
 }  // namespace
@@ -232,8 +269,7 @@ bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
   return !content_setting_rules_ ||
-         ::IsBraveShieldsDown(frame, secondary_url,
-                              content_setting_rules_->brave_shields_rules);
+         ::IsBraveShieldsDown(frame, secondary_url, *content_setting_rules_);
 }
 
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
@@ -259,9 +295,8 @@ BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
-    setting = GetBraveContentSettingFromRules(
-        content_setting_rules_->brave_shields_rules,
-        content_setting_rules_->fingerprinting_rules, frame,
+    setting = GetBraveFingerprintingSettingFromRules(
+        *content_setting_rules_, frame,
         url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL());
   }
 
@@ -200,6 +200,9 @@ void ChromeImporter::ImportHistory() {
   s.BindInt64(3, ui::PAGE_TRANSITION_MANUAL_SUBFRAME);
   s.BindInt64(4, ui::PAGE_TRANSITION_KEYWORD_GENERATED);
 
+  // The rows are sent in a single call: the browser side commits history
+  // once it has received as many rows as announced, and the bridge already
+  // splits them into small IPC messages.
   std::vector<ImporterURLRow> rows;
   while (s.Step() && !cancelled()) {
     GURL url(s.ColumnString(0));
@@ -212,7 +215,7 @@ void ChromeImporter::ImportHistory() {
     row.typed_count = s.ColumnInt(3);
     row.visit_count = s.ColumnInt(4);
 
-    rows.push_back(row);
+    rows.push_back(std::move(row));
   }
 
   if (!rows.empty() && !cancelled())
@@ -284,11 +287,8 @@ void ChromeImporter::ImportBookmarks() {
   FaviconMap favicon_map;
   ImportFaviconURLs(&db, &favicon_map);
   // Write favicons into profile.
-  if (!favicon_map.empty() && !cancelled()) {
-    favicon_base::FaviconUsageDataList favicons;
-    LoadFaviconData(&db, favicon_map, &favicons);
-    bridge_->SetFavicons(favicons);
-  }
+  if (!favicon_map.empty() && !cancelled())
+    ImportFaviconData(&db, favicon_map);
 }
 
 void ChromeImporter::ImportFaviconURLs(
@@ -304,43 +304,53 @@ void ChromeImporter::ImportFaviconURLs(
   }
 }
 
-void ChromeImporter::LoadFaviconData(
-    sql::Database* db,
-    const FaviconMap& favicon_map,
-    favicon_base::FaviconUsageDataList* favicons) {
-  const char query[] = "SELECT f.url, fb.image_data "
+void ChromeImporter::ImportFaviconData(sql::Database* db,
+                                       const FaviconMap& favicon_map) {
+  // Walk all the mapped icons at once instead of querying them one by one.
+  // Only the first bitmap of every icon is used.
+  const char query[] = "SELECT f.id, f.url, fb.image_data "
                        "FROM favicons f "
                        "JOIN favicon_bitmaps fb "
                        "ON f.id = fb.icon_id "
-                       "WHERE f.id = ?;";
+                       "WHERE f.id IN (SELECT icon_id FROM icon_mapping) "
+                       "ORDER BY f.id;";
   sql::Statement s(db->GetUniqueStatement(query));
 
   if (!s.is_valid())
     return;
 
-  for (FaviconMap::const_iterator i = favicon_map.begin();
-       i != favicon_map.end(); ++i) {
-    s.BindInt64(0, i->first);
-    if (s.Step()) {
-      favicon_base::FaviconUsageData usage;
+  favicon_base::FaviconUsageDataList favicons;
+  int64_t last_icon_id = -1;
+  while (s.Step() && !cancelled()) {
+    int64_t icon_id = s.ColumnInt64(0);
+    if (icon_id == last_icon_id)
+      continue;
+    last_icon_id = icon_id;
 
-      usage.favicon_url = GURL(s.ColumnString(0));
-      if (!usage.favicon_url.is_valid())
-        continue;  // Don't bother importing favicons with invalid URLs.
+    FaviconMap::const_iterator i = favicon_map.find(icon_id);
+    if (i == favicon_map.end())
+      continue;
 
-      std::vector<unsigned char> data;
-      s.ColumnBlobAsVector(1, &data);
-      if (data.empty())
-        continue;  // Data definitely invalid.
+    favicon_base::FaviconUsageData usage;
 
-      if (!importer::ReencodeFavicon(&data[0], data.size(), &usage.png_data))
-        continue;  // Unable to decode.
+    usage.favicon_url = GURL(s.ColumnString(1));
+    if (!usage.favicon_url.is_valid())
+      continue;  // Don't bother importing favicons with invalid URLs.
 
-      usage.urls = i->second;
-      favicons->push_back(usage);
-    }
-    s.Reset(true);
+    std::vector<unsigned char> data;
+    s.ColumnBlobAsVector(2, &data);
+    if (data.empty())
+      continue;  // Data definitely invalid.
+
+    if (!importer::ReencodeFavicon(&data[0], data.size(), &usage.png_data))
+      continue;  // Unable to decode.
+
+    usage.urls = i->second;
+    favicons.push_back(std::move(usage));
   }
+
+  if (!favicons.empty() && !cancelled())
+    bridge_->SetFavicons(favicons);
 }
 
 void ChromeImporter::RecursiveReadBookmarksFolder(
@@ -61,10 +61,9 @@ class ChromeImporter : public Importer {
     sql::Database* db,
     FaviconMap* favicon_map);
 
-  // Loads and reencodes the individual favicons.
-  void LoadFaviconData(sql::Database* db,
-                       const FaviconMap& favicon_map,
-                       favicon_base::FaviconUsageDataList* favicons);
+  // Loads and reencodes the individual favicons with a single query and
+  // sends them to the bridge.
+  void ImportFaviconData(sql::Database* db, const FaviconMap& favicon_map);
 
   void RecursiveReadBookmarksFolder(
     const base::DictionaryValue* folder,
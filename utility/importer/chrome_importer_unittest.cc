@@ -5,22 +5,38 @@
 
 #include "brave/utility/importer/chrome_importer.h"
 
+#include <map>
 #include <string>
+#include <utility>
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/brave_paths.h"
+#include "chrome/browser/importer/external_process_importer_client.h"
+#include "chrome/browser/importer/in_process_importer_bridge.h"
+#include "chrome/browser/importer/profile_writer.h"
 #include "chrome/common/chrome_paths.h"
 #include "chrome/common/importer/imported_bookmark_entry.h"
 #include "chrome/common/importer/importer_data_types.h"
 #include "chrome/common/importer/importer_url_row.h"
 #include "chrome/common/importer/mock_importer_bridge.h"
+#include "chrome/common/importer/profile_import.mojom.h"
+#include "chrome/utility/importer/external_process_importer_bridge.h"
 #include "components/favicon_base/favicon_usage_data.h"
+#include "components/history/core/browser/history_types.h"
 #include "components/os_crypt/os_crypt_mocker.h"
+#include "content/public/test/browser_task_environment.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/shared_remote.h"
+#include "sql/database.h"
+#include "sql/statement.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "ui/base/page_transition_types.h"
 
 using base::ASCIIToUTF16;
 using base::UTF16ToASCII;
@@ -38,6 +54,87 @@ base::FilePath GetTestChromeProfileDir(const std::string& profile) {
       .AppendASCII(profile);
 }
 
+namespace {
+
+// Replaces the History database at |history_path| with one holding
+// |row_count| distinct visited URLs.
+void CreateSyntheticHistory(const base::FilePath& history_path,
+                            size_t row_count) {
+  ASSERT_TRUE(base::DeleteFile(history_path, false));
+  sql::Database db;
+  ASSERT_TRUE(db.Open(history_path));
+  ASSERT_TRUE(db.Execute(
+      "CREATE TABLE urls(id INTEGER PRIMARY KEY, url LONGVARCHAR, "
+      "title LONGVARCHAR, visit_count INTEGER, typed_count INTEGER, "
+      "hidden INTEGER)"));
+  ASSERT_TRUE(db.Execute(
+      "CREATE TABLE visits(id INTEGER PRIMARY KEY, url INTEGER, "
+      "visit_time INTEGER, transition INTEGER)"));
+  ASSERT_TRUE(db.BeginTransaction());
+  sql::Statement url_statement(db.GetUniqueStatement(
+      "INSERT INTO urls(id, url, title, visit_count, typed_count, hidden) "
+      "VALUES (?, ?, 'title', 1, 0, 0)"));
+  sql::Statement visit_statement(db.GetUniqueStatement(
+      "INSERT INTO visits(url, visit_time, transition) VALUES (?, ?, ?)"));
+  for (size_t i = 0; i < row_count; ++i) {
+    url_statement.BindInt64(0, i + 1);
+    url_statement.BindString(
+        1, "https://example" + base::NumberToString(i) + ".com/");
+    ASSERT_TRUE(url_statement.Run());
+    url_statement.Reset(true);
+
+    visit_statement.BindInt64(0, i + 1);
+    visit_statement.BindInt64(1, 13000000000000000 + i);
+    visit_statement.BindInt64(
+        2, ui::PAGE_TRANSITION_LINK | ui::PAGE_TRANSITION_CHAIN_END);
+    ASSERT_TRUE(visit_statement.Run());
+    visit_statement.Reset(true);
+  }
+  ASSERT_TRUE(db.CommitTransaction());
+}
+
+// Counts how many times each history URL would be written to the profile.
+class RecordingProfileWriter : public ProfileWriter {
+ public:
+  RecordingProfileWriter() : ProfileWriter(nullptr) {}
+
+  void AddHistoryPage(const history::URLRows& page,
+                      history::VisitSource visit_source) override {
+    for (const history::URLRow& row : page)
+      ++history_writes_[row.url()];
+  }
+
+  const std::map<GURL, int>& history_writes() const { return history_writes_; }
+
+ private:
+  ~RecordingProfileWriter() override = default;
+
+  std::map<GURL, int> history_writes_;
+};
+
+// The browser side importer client, minus the notifications that would go
+// to an ExternalProcessImporterHost.
+class TestImporterClient : public ExternalProcessImporterClient {
+ public:
+  TestImporterClient(const importer::SourceProfile& source_profile,
+                     InProcessImporterBridge* bridge)
+      : ExternalProcessImporterClient(nullptr,
+                                      source_profile,
+                                      importer::HISTORY,
+                                      bridge) {}
+
+  void OnImportStart() override {}
+  void OnImportFinished(bool succeeded, const std::string& error_msg) override {
+  }
+  void OnImportItemStart(importer::ImportItem item) override {}
+  void OnImportItemFinished(importer::ImportItem item) override {}
+
+ private:
+  ~TestImporterClient() override = default;
+};
+
+}  // namespace
+
 class ChromeImporterTest : public ::testing::Test {
  protected:
   void SetUpChromeProfile() {
@@ -87,6 +184,38 @@ TEST_F(ChromeImporterTest, ImportHistory) {
   EXPECT_EQ("https://www.nytimes.com/", history[2].url.spec());
 }
 
+// Runs the import through the real bridge and browser side importer client
+// and checks that every row is written to the profile exactly once.
+TEST_F(ChromeImporterTest, ImportLargeHistoryThroughImporterClient) {
+  content::BrowserTaskEnvironment task_environment;
+  // Large enough for the bridge to split the rows into many IPC messages.
+  const size_t kRowCount = 2501;
+  ASSERT_NO_FATAL_FAILURE(
+      CreateSyntheticHistory(profile_dir_.AppendASCII("History"), kRowCount));
+
+  auto writer = base::MakeRefCounted<RecordingProfileWriter>();
+  auto in_process_bridge =
+      base::MakeRefCounted<InProcessImporterBridge>(writer.get(), nullptr);
+  auto client =
+      base::MakeRefCounted<TestImporterClient>(profile_,
+                                               in_process_bridge.get());
+
+  mojo::PendingRemote<chrome::mojom::ProfileImportObserver> observer;
+  mojo::Receiver<chrome::mojom::ProfileImportObserver> receiver(
+      client.get(), observer.InitWithNewPipeAndPassReceiver());
+  auto bridge = base::MakeRefCounted<ExternalProcessImporterBridge>(
+      base::flat_map<uint32_t, std::string>(),
+      mojo::SharedRemote<chrome::mojom::ProfileImportObserver>(
+          std::move(observer)));
+
+  importer_->StartImport(profile_, importer::HISTORY, bridge.get());
+  task_environment.RunUntilIdle();
+
+  ASSERT_EQ(kRowCount, writer->history_writes().size());
+  for (const auto& write : writer->history_writes())
+    EXPECT_EQ(1, write.second) << write.first;
+}
+
 TEST_F(ChromeImporterTest, ImportBookmarks) {
   std::vector<ImportedBookmarkEntry> bookmarks;
 